@@ -6,6 +6,7 @@
  * pointer arithmetic - array of 15 elements
  */
 #include "../connor.h"
+#include "../trace.h"
 
 class Composer {
   string name;
@@ -14,16 +15,16 @@ class Composer {
 public:
   // Explicit constructor
   explicit Composer(string n, int y) : name{n}, birthYear{y} {
-    cout << "Constructed: " << name << "\n";
+    TRACE(trace::detail, trace::special_members, "Constructed: {}", name);
   }
 
   // Copy constructor
   Composer(const Composer &c) : name{c.name}, birthYear{c.birthYear} {
-    cout << "Copied: " << name << "\n";
+    TRACE(trace::detail, trace::special_members, "Copied: {}", name);
   }
   // Move constructor
   Composer(Composer &&c) noexcept : name{move(c.name)}, birthYear{c.birthYear} {
-    cout << "Moved: " << name << "\n";
+    TRACE(trace::detail, trace::special_members, "Moved: {}", name);
   }
 
   // Copy assignment
@@ -31,7 +32,7 @@ public:
     if (this != &c) {
       name = c.name;
       birthYear = c.birthYear;
-      cout << "Copy-assigned: " << name << "\n";
+      TRACE(trace::detail, trace::special_members, "Copy-assigned: {}", name);
     }
     return *this;
   }
@@ -41,7 +42,7 @@ public:
     if (this != &c) {
       name = move(c.name);
       birthYear = c.birthYear;
-      cout << "Move-assigned\n";
+      TRACE(trace::detail, trace::special_members, "Move-assigned");
     }
     return *this;
   }
@@ -1,5 +1,6 @@
 // chapter 17
 #include "../connor.h"
+#include "../trace.h"
 #include <iostream>
 #include <memory>
 #include <string>
@@ -22,12 +23,12 @@ private:
 public:
   // Default Constructor
   MyString() : data(nullptr), size(0) {
-    cout << "  Default constructor called\n";
+    TRACE(trace::detail, trace::special_members, "Default constructor called");
   }
 
   // Regular Constructor
   MyString(const char *str) {
-    cout << "  Regular constructor called\n";
+    TRACE(trace::detail, trace::special_members, "Regular constructor called");
     if (str) {
       size = strlen(str);
       data = new char[size + 1];
@@ -40,7 +41,7 @@ public:
 
   // Copy Constructor - DEEP COPY
   MyString(const MyString &other) {
-    cout << "  Copy constructor called\n";
+    TRACE(trace::detail, trace::special_members, "Copy constructor called");
     size = other.size;
     if (other.data) {
       data = new char[size + 1];
@@ -52,7 +53,7 @@ public:
 
   // Move Constructor - TRANSFER OWNERSHIP
   MyString(MyString &&other) noexcept {
-    cout << "  Move constructor called\n";
+    TRACE(trace::detail, trace::special_members, "Move constructor called");
     data = other.data;
     size = other.size;
     other.data = nullptr; // Leave source in valid state
@@ -61,9 +62,9 @@ public:
 
   // Copy Assignment
   MyString &operator=(const MyString &other) {
-    cout << "  Copy assignment called\n";
+    TRACE(trace::detail, trace::special_members, "Copy assignment called");
     if (this == &other) { // Self-assignment check
-      cout << "    Self-assignment detected!\n";
+      TRACE(trace::detail, trace::special_members, "Self-assignment detected!");
       return *this;
     }
 
@@ -83,7 +84,7 @@ public:
 
   // Move Assignment
   MyString &operator=(MyString &&other) noexcept {
-    cout << "  Move assignment called\n";
+    TRACE(trace::detail, trace::special_members, "Move assignment called");
     if (this == &other)
       return *this;
 
@@ -100,7 +101,8 @@ public:
 
   // Destructor
   ~MyString() {
-    cout << "  Destructor called for: \"" << (data ? data : "null") << "\"\n";
+    TRACE(trace::detail, trace::special_members,
+          "Destructor called for: \"{}\"", data);
     delete[] data;
   }
 
@@ -0,0 +1,215 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * + - * / on whole arrays of numbers (FixedArray, or DynamicArray when the
+ * size isn't known up front) without a temporary array per operator.
+ * a + b * c doesn't compute anything; it builds a small object that
+ * remembers the operation, and the work happens in one loop when it is
+ * stored:
+ *
+ *   DynamicArray<double> r = a + b * c;   // r[i] = a[i] + b[i] * c[i]
+ *
+ * each element's type is whatever the operator gives for one value, the
+ * same decltype(a + b) that add_different_types uses: ints times 0.5 are
+ * doubles. plain numbers mix in too (2 * a). an expression only keeps
+ * references to its arrays, so store it before they go away; don't keep
+ * one in an auto variable.
+ */
+
+#include "../connor.h"
+#include "fixed_array.h"
+#include "numeric.h"
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+template <typename T> class DynamicArray;
+
+namespace array_expr {
+
+// the arrays an expression can start from
+template <typename A> struct is_array : false_type {};
+template <Numeric T, size_t N>
+struct is_array<FixedArray<T, N>> : true_type {};
+template <Numeric T> struct is_array<DynamicArray<T>> : true_type {};
+
+// a built expression, not yet computed
+template <typename E>
+concept Node = requires { typename E::is_expression; };
+
+template <typename A>
+concept Array = is_array<A>::value || Node<A>;
+
+// a plain number used against a whole array: the same value at every i
+template <Numeric T> struct Scalar {
+  using value_type = T;
+  T value;
+  constexpr T operator[](size_t) const { return value; }
+};
+
+template <typename A> struct is_scalar : false_type {};
+template <typename T> struct is_scalar<Scalar<T>> : true_type {};
+template <typename A> constexpr bool is_scalar_v = is_scalar<A>::value;
+
+// arrays are kept by reference; nodes and numbers are small, so by value
+template <typename A>
+using held_t = conditional_t<is_array<A>::value, const A &, A>;
+
+template <typename A> constexpr decltype(auto) wrap(const A &a) {
+  if constexpr (Numeric<A>)
+    return Scalar<A>{a};
+  else
+    return held_t<A>(a);
+}
+template <typename A>
+using wrapped_t = remove_cvref_t<decltype(wrap(declval<const A &>()))>;
+
+// Op applied to the values of left and right at each i
+template <typename Op, typename L, typename R> class Binary {
+public:
+  using is_expression = void;
+  using value_type = decltype(Op{}(declval<typename L::value_type>(),
+                                   declval<typename R::value_type>()));
+
+  // two arrays have to be the same size, empty ones included; a plain
+  // number goes with any size
+  constexpr Binary(const L &l, const R &r) : left{l}, right{r} {
+    if constexpr (!is_scalar_v<L> && !is_scalar_v<R>)
+      if (left.size() != right.size())
+        throw invalid_argument("array expression: sizes differ");
+  }
+
+  constexpr value_type operator[](size_t i) const {
+    return Op{}(left[i], right[i]);
+  }
+  constexpr size_t size() const {
+    if constexpr (is_scalar_v<L>)
+      return right.size();
+    else
+      return left.size();
+  }
+
+  // lets a whole expression be stored into a FixedArray directly
+  template <typename T, size_t N> constexpr operator FixedArray<T, N>() const {
+    FixedArray<T, N> out;
+    assign(out, *this);
+    return out;
+  }
+
+private:
+  held_t<L> left;
+  held_t<R> right;
+};
+
+template <typename Op, typename A> class Unary {
+public:
+  using is_expression = void;
+  using value_type = decltype(Op{}(declval<typename A::value_type>()));
+
+  constexpr explicit Unary(const A &a) : arg{a} {}
+
+  constexpr value_type operator[](size_t i) const { return Op{}(arg[i]); }
+  constexpr size_t size() const { return arg.size(); }
+
+  template <typename T, size_t N> constexpr operator FixedArray<T, N>() const {
+    FixedArray<T, N> out;
+    assign(out, *this);
+    return out;
+  }
+
+private:
+  held_t<A> arg;
+};
+
+// the one loop that computes a whole expression into out. every operand
+// is read once per i and nothing in between is stored, so the compiler
+// can keep it all in registers (and vectorize it).
+template <typename Out, Node E> constexpr void assign(Out &out, const E &e) {
+  using T = typename Out::value_type;
+  size_t n = e.size();
+  out.resize(n);
+  T *dest = out.data();
+  for (size_t i = 0; i < n; ++i)
+    dest[i] = static_cast<T>(e[i]);
+}
+
+template <typename Op, typename L, typename R>
+constexpr auto make(const L &l, const R &r) {
+  return Binary<Op, wrapped_t<L>, wrapped_t<R>>(wrap(l), wrap(r));
+}
+
+} // namespace array_expr
+
+// a vector of numbers that can be the start or the end of an expression
+template <typename T> class DynamicArray {
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using iterator = typename vector<T>::iterator;
+  using const_iterator = typename vector<T>::const_iterator;
+
+  DynamicArray() = default;
+  explicit DynamicArray(size_t n, const T &value = T{}) : values(n, value) {}
+  DynamicArray(initializer_list<T> list) : values(list) {}
+  template <array_expr::Node E> DynamicArray(const E &e) {
+    array_expr::assign(*this, e);
+  }
+  template <array_expr::Node E> DynamicArray &operator=(const E &e) {
+    array_expr::assign(*this, e); // a = a * 2 is fine: same i in and out
+    return *this;
+  }
+
+  size_t size() const { return values.size(); }
+  bool empty() const { return values.empty(); }
+  T *data() { return values.data(); }
+  const T *data() const { return values.data(); }
+  T &operator[](size_t i) { return values[i]; }
+  const T &operator[](size_t i) const { return values[i]; }
+
+  iterator begin() { return values.begin(); }
+  iterator end() { return values.end(); }
+  const_iterator begin() const { return values.begin(); }
+  const_iterator end() const { return values.end(); }
+
+  void push_back(const T &value) { values.push_back(value); }
+  void resize(size_t n) { values.resize(n); }
+
+private:
+  vector<T> values;
+};
+
+// the operators. at least one side has to be an array or an expression;
+// the other can be a plain number.
+template <typename A>
+concept ArrayOperand = array_expr::Array<A> || Numeric<A>;
+
+template <ArrayOperand L, ArrayOperand R>
+  requires(array_expr::Array<L> || array_expr::Array<R>)
+constexpr auto operator+(const L &l, const R &r) {
+  return array_expr::make<plus<>>(l, r);
+}
+template <ArrayOperand L, ArrayOperand R>
+  requires(array_expr::Array<L> || array_expr::Array<R>)
+constexpr auto operator-(const L &l, const R &r) {
+  return array_expr::make<minus<>>(l, r);
+}
+template <ArrayOperand L, ArrayOperand R>
+  requires(array_expr::Array<L> || array_expr::Array<R>)
+constexpr auto operator*(const L &l, const R &r) {
+  return array_expr::make<multiplies<>>(l, r);
+}
+template <ArrayOperand L, ArrayOperand R>
+  requires(array_expr::Array<L> || array_expr::Array<R>)
+constexpr auto operator/(const L &l, const R &r) {
+  return array_expr::make<divides<>>(l, r);
+}
+template <array_expr::Array A> constexpr auto operator-(const A &a) {
+  using W = array_expr::wrapped_t<A>;
+  return array_expr::Unary<negate<>, W>(array_expr::wrap(a));
+}
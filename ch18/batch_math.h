@@ -0,0 +1,430 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * the Numeric templates from chapter18_practice.cpp (square, maximum,
+ * add_different_types) plus sum and dot, over a whole array at a time.
+ * they take anything laid out like an array (vector, array, FixedArray,
+ * span) and work through it several values per instruction with AVX2 or
+ * SSE, whichever the compiler was told it may use (-mavx2, -march=native).
+ * types or targets without vector instructions get a plain loop. integer
+ * results wrap around in the element type, in the registers and in the
+ * plain loop alike (where the one-value versions would overflow, which is
+ * undefined for signed types); float sums add in a different order, so
+ * the last bits can differ.
+ */
+
+#include "../connor.h"
+#include "numeric.h"
+#include <concepts>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace batch {
+namespace simd {
+
+// one vector register of T: how many fit, and the instructions for it.
+// only types the target can add, multiply and compare in a register get
+// one; for the rest (long long, char, ...) vector is false.
+template <typename T> struct Lanes {
+  static constexpr bool vector = false;
+};
+
+// loads Lanes<R>::width values of T as R, for add() on mixed types
+template <typename R, typename T> struct Widen {
+  static constexpr bool vector = false;
+};
+template <typename T> struct Widen<T, T> {
+  static constexpr bool vector = Lanes<T>::vector;
+  static auto load(const T *p) { return Lanes<T>::load(p); }
+};
+
+#if defined(__AVX2__)
+
+template <> struct Lanes<float> {
+  using Reg = __m256;
+  static constexpr bool vector = true;
+  static constexpr size_t width = 8;
+  static Reg load(const float *p) { return _mm256_loadu_ps(p); }
+  static void store(float *p, Reg r) { _mm256_storeu_ps(p, r); }
+  static Reg fill(float v) { return _mm256_set1_ps(v); }
+  static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+};
+
+template <> struct Lanes<double> {
+  using Reg = __m256d;
+  static constexpr bool vector = true;
+  static constexpr size_t width = 4;
+  static Reg load(const double *p) { return _mm256_loadu_pd(p); }
+  static void store(double *p, Reg r) { _mm256_storeu_pd(p, r); }
+  static Reg fill(double v) { return _mm256_set1_pd(v); }
+  static Reg add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm256_max_pd(a, b); }
+};
+
+// 16 and 32 bit integers share a register type; multiply and max pick the
+// instruction for the size and sign. the low half of a product is the
+// same bits signed or not, which is the wrapped-around result.
+template <typename T> struct IntLanes {
+  using Reg = __m256i;
+  static constexpr bool vector = true;
+  static constexpr size_t width = 32 / sizeof(T);
+  static Reg load(const T *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const Reg *>(p));
+  }
+  static void store(T *p, Reg r) {
+    _mm256_storeu_si256(reinterpret_cast<Reg *>(p), r);
+  }
+  static Reg fill(T v) {
+    if constexpr (sizeof(T) == 4)
+      return _mm256_set1_epi32(static_cast<int>(v));
+    else
+      return _mm256_set1_epi16(static_cast<short>(v));
+  }
+  static Reg add(Reg a, Reg b) {
+    if constexpr (sizeof(T) == 4)
+      return _mm256_add_epi32(a, b);
+    else
+      return _mm256_add_epi16(a, b);
+  }
+  static Reg mul(Reg a, Reg b) {
+    if constexpr (sizeof(T) == 4)
+      return _mm256_mullo_epi32(a, b);
+    else
+      return _mm256_mullo_epi16(a, b);
+  }
+  static Reg max(Reg a, Reg b) {
+    if constexpr (sizeof(T) == 4 && is_signed_v<T>)
+      return _mm256_max_epi32(a, b);
+    else if constexpr (sizeof(T) == 4)
+      return _mm256_max_epu32(a, b);
+    else if constexpr (is_signed_v<T>)
+      return _mm256_max_epi16(a, b);
+    else
+      return _mm256_max_epu16(a, b);
+  }
+};
+template <> struct Lanes<int32_t> : IntLanes<int32_t> {};
+template <> struct Lanes<uint32_t> : IntLanes<uint32_t> {};
+template <> struct Lanes<int16_t> : IntLanes<int16_t> {};
+template <> struct Lanes<uint16_t> : IntLanes<uint16_t> {};
+
+template <> struct Widen<double, float> {
+  static constexpr bool vector = true;
+  static __m256d load(const float *p) {
+    return _mm256_cvtps_pd(_mm_loadu_ps(p));
+  }
+};
+template <> struct Widen<double, int32_t> {
+  static constexpr bool vector = true;
+  static __m256d load(const int32_t *p) {
+    return _mm256_cvtepi32_pd(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+  }
+};
+template <> struct Widen<float, int32_t> {
+  static constexpr bool vector = true;
+  static __m256 load(const int32_t *p) {
+    return _mm256_cvtepi32_ps(Lanes<int32_t>::load(p));
+  }
+};
+// short + short is an int in C++, so these are the common mixed adds
+template <> struct Widen<int32_t, int16_t> {
+  static constexpr bool vector = true;
+  static __m256i load(const int16_t *p) {
+    return _mm256_cvtepi16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+  }
+};
+template <> struct Widen<int32_t, uint16_t> {
+  static constexpr bool vector = true;
+  static __m256i load(const uint16_t *p) {
+    return _mm256_cvtepu16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+  }
+};
+
+#elif defined(__SSE2__)
+
+template <> struct Lanes<float> {
+  using Reg = __m128;
+  static constexpr bool vector = true;
+  static constexpr size_t width = 4;
+  static Reg load(const float *p) { return _mm_loadu_ps(p); }
+  static void store(float *p, Reg r) { _mm_storeu_ps(p, r); }
+  static Reg fill(float v) { return _mm_set1_ps(v); }
+  static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+};
+
+template <> struct Lanes<double> {
+  using Reg = __m128d;
+  static constexpr bool vector = true;
+  static constexpr size_t width = 2;
+  static Reg load(const double *p) { return _mm_loadu_pd(p); }
+  static void store(double *p, Reg r) { _mm_storeu_pd(p, r); }
+  static Reg fill(double v) { return _mm_set1_pd(v); }
+  static Reg add(Reg a, Reg b) { return _mm_add_pd(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm_mul_pd(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm_max_pd(a, b); }
+};
+
+template <> struct Widen<double, float> {
+  static constexpr bool vector = true;
+  static __m128d load(const float *p) {
+    __m128i two = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p));
+    return _mm_cvtps_pd(_mm_castsi128_ps(two));
+  }
+};
+template <> struct Widen<double, int32_t> {
+  static constexpr bool vector = true;
+  static __m128d load(const int32_t *p) {
+    return _mm_cvtepi32_pd(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+  }
+};
+template <> struct Widen<float, int32_t> {
+  static constexpr bool vector = true;
+  static __m128 load(const int32_t *p) {
+    return _mm_cvtepi32_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+  }
+};
+
+// SSE2 alone has no 32-bit multiply or unsigned max; the integer lanes
+// need SSE4.1
+#if defined(__SSE4_1__)
+template <typename T> struct IntLanes {
+  using Reg = __m128i;
+  static constexpr bool vector = true;
+  static constexpr size_t width = 16 / sizeof(T);
+  static Reg load(const T *p) {
+    return _mm_loadu_si128(reinterpret_cast<const Reg *>(p));
+  }
+  static void store(T *p, Reg r) {
+    _mm_storeu_si128(reinterpret_cast<Reg *>(p), r);
+  }
+  static Reg fill(T v) {
+    if constexpr (sizeof(T) == 4)
+      return _mm_set1_epi32(static_cast<int>(v));
+    else
+      return _mm_set1_epi16(static_cast<short>(v));
+  }
+  static Reg add(Reg a, Reg b) {
+    if constexpr (sizeof(T) == 4)
+      return _mm_add_epi32(a, b);
+    else
+      return _mm_add_epi16(a, b);
+  }
+  static Reg mul(Reg a, Reg b) {
+    if constexpr (sizeof(T) == 4)
+      return _mm_mullo_epi32(a, b);
+    else
+      return _mm_mullo_epi16(a, b);
+  }
+  static Reg max(Reg a, Reg b) {
+    if constexpr (sizeof(T) == 4 && is_signed_v<T>)
+      return _mm_max_epi32(a, b);
+    else if constexpr (sizeof(T) == 4)
+      return _mm_max_epu32(a, b);
+    else if constexpr (is_signed_v<T>)
+      return _mm_max_epi16(a, b);
+    else
+      return _mm_max_epu16(a, b);
+  }
+};
+template <> struct Lanes<int32_t> : IntLanes<int32_t> {};
+template <> struct Lanes<uint32_t> : IntLanes<uint32_t> {};
+template <> struct Lanes<int16_t> : IntLanes<int16_t> {};
+template <> struct Lanes<uint16_t> : IntLanes<uint16_t> {};
+
+template <> struct Widen<int32_t, int16_t> {
+  static constexpr bool vector = true;
+  static __m128i load(const int16_t *p) {
+    return _mm_cvtepi16_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+  }
+};
+template <> struct Widen<int32_t, uint16_t> {
+  static constexpr bool vector = true;
+  static __m128i load(const uint16_t *p) {
+    return _mm_cvtepu16_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+  }
+};
+#endif // __SSE4_1__
+
+#endif
+
+// the one-value math for the leftovers. integers are multiplied and added
+// as unsigned (at least as wide as unsigned, so short doesn't turn back
+// into a signed int), where overflow wraps around like the registers do
+// instead of being undefined, and then converted back to T.
+template <typename T> struct Wrapping {
+  using type = T;
+};
+template <typename T>
+  requires(is_integral_v<T> && !is_same_v<T, bool>)
+struct Wrapping<T> {
+  using type = conditional_t<(sizeof(T) < sizeof(unsigned)), unsigned,
+                             make_unsigned_t<T>>;
+};
+template <typename T> using wrapping_t = typename Wrapping<T>::type;
+
+template <typename T> T wrapping_mul(T a, T b) {
+  using W = wrapping_t<T>;
+  return static_cast<T>(static_cast<W>(a) * static_cast<W>(b));
+}
+template <typename T> T wrapping_add(T a, T b) {
+  using W = wrapping_t<T>;
+  return static_cast<T>(static_cast<W>(a) + static_cast<W>(b));
+}
+
+// the kernels. each does whole registers while it can and finishes the
+// last few values (or all of them, with no vector type) one at a time.
+
+template <typename T> void square(const T *in, T *out, size_t n) {
+  size_t i = 0;
+  if constexpr (Lanes<T>::vector) {
+    using L = Lanes<T>;
+    for (; i + L::width <= n; i += L::width) {
+      auto v = L::load(in + i);
+      L::store(out + i, L::mul(v, v));
+    }
+  }
+  for (; i < n; ++i)
+    out[i] = wrapping_mul(in[i], in[i]);
+}
+
+// sum and dot keep four running totals so each add doesn't wait on the
+// one before it
+template <typename T, bool Multiply>
+T sum_of(const T *a, const T *b, size_t n) {
+  T total = 0;
+  size_t i = 0;
+  if constexpr (Lanes<T>::vector) {
+    using L = Lanes<T>;
+    constexpr size_t w = L::width;
+    auto next = [&](size_t at) {
+      if constexpr (Multiply)
+        return L::mul(L::load(a + at), L::load(b + at));
+      else
+        return L::load(a + at);
+    };
+    typename L::Reg acc[4] = {L::fill(0), L::fill(0), L::fill(0), L::fill(0)};
+    for (; i + 4 * w <= n; i += 4 * w)
+      for (size_t k = 0; k < 4; ++k)
+        acc[k] = L::add(acc[k], next(i + k * w));
+    for (; i + w <= n; i += w)
+      acc[0] = L::add(acc[0], next(i));
+    T lanes[w];
+    L::store(lanes, L::add(L::add(acc[0], acc[1]), L::add(acc[2], acc[3])));
+    for (T v : lanes)
+      total = wrapping_add(total, v);
+  }
+  for (; i < n; ++i)
+    total = wrapping_add(total, Multiply ? wrapping_mul(a[i], b[i]) : a[i]);
+  return total;
+}
+
+// n must be at least 1
+template <typename T> T maximum(const T *in, size_t n) {
+  T best = in[0];
+  size_t i = 0;
+  if constexpr (Lanes<T>::vector) {
+    using L = Lanes<T>;
+    if (n >= L::width) {
+      typename L::Reg acc = L::fill(best);
+      for (; i + L::width <= n; i += L::width)
+        acc = L::max(acc, L::load(in + i));
+      T lanes[L::width];
+      L::store(lanes, acc);
+      for (T v : lanes)
+        best = (best > v) ? best : v;
+    }
+  }
+  for (; i < n; ++i)
+    best = (best > in[i]) ? best : in[i];
+  return best;
+}
+
+template <typename R, typename T, typename U>
+void add(const T *a, const U *b, R *out, size_t n) {
+  size_t i = 0;
+  if constexpr (Widen<R, T>::vector && Widen<R, U>::vector) {
+    using L = Lanes<R>;
+    for (; i + L::width <= n; i += L::width)
+      L::store(out + i,
+               L::add(Widen<R, T>::load(a + i), Widen<R, U>::load(b + i)));
+  }
+  for (; i < n; ++i)
+    out[i] = wrapping_add(static_cast<R>(a[i]), static_cast<R>(b[i]));
+}
+
+} // namespace simd
+
+// an array-like range of one Numeric type
+template <typename R>
+concept Numbers = ranges::contiguous_range<R> && ranges::sized_range<R> &&
+                  Numeric<ranges::range_value_t<R>>;
+
+template <Numbers R> using element_t = ranges::range_value_t<R>;
+
+// out[i] = in[i] * in[i]. out can be in itself.
+template <Numbers In, Numbers Out>
+  requires same_as<element_t<In>, element_t<Out>>
+void square(const In &in, Out &&out) {
+  if (ranges::size(out) < ranges::size(in))
+    throw invalid_argument("batch::square: output is shorter than input");
+  simd::square(ranges::data(in), ranges::data(out), ranges::size(in));
+}
+
+// the biggest value; throws if there are none
+template <Numbers In> element_t<In> maximum(const In &in) {
+  if (ranges::empty(in))
+    throw invalid_argument("batch::maximum: no values");
+  return simd::maximum(ranges::data(in), ranges::size(in));
+}
+
+template <Numbers In> element_t<In> sum(const In &in) {
+  return simd::sum_of<element_t<In>, false>(ranges::data(in), nullptr,
+                                             ranges::size(in));
+}
+
+// a[0] * b[0] + a[1] * b[1] + ...
+template <Numbers A, Numbers B>
+  requires same_as<element_t<A>, element_t<B>>
+element_t<A> dot(const A &a, const B &b) {
+  if (ranges::size(a) != ranges::size(b))
+    throw invalid_argument("batch::dot: sizes differ");
+  return simd::sum_of<element_t<A>, true>(ranges::data(a), ranges::data(b),
+                                           ranges::size(a));
+}
+
+// out[i] = a[i] + b[i], where out holds whatever type a[i] + b[i] is, the
+// same as add_different_types: int and double give double
+template <Numbers A, Numbers B, Numbers Out>
+  requires same_as<element_t<Out>,
+                   decltype(declval<element_t<A>>() + declval<element_t<B>>())>
+void add(const A &a, const B &b, Out &&out) {
+  if (ranges::size(a) != ranges::size(b) ||
+      ranges::size(out) < ranges::size(a))
+    throw invalid_argument("batch::add: sizes differ");
+  simd::add(ranges::data(a), ranges::data(b), ranges::data(out),
+            ranges::size(a));
+}
+
+} // namespace batch
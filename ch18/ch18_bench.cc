@@ -0,0 +1,323 @@
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * timings for the ch18 templates
+ * usage: ch18_bench [section] [count]
+ * the trace section writes its records to cerr; send them to /dev/null
+ */
+
+#include "../connor.h"
+#include "../trace.h"
+#include "array_expr.h"
+#include "batch_math.h"
+#include "fixed_array.h"
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+
+template <typename F> double time_ms(F &&f) {
+  auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+// FixedArray the way chapter18_practice.cpp first had it: T data[SIZE]
+// constructs (and later destroys) all SIZE values up front
+template <typename T, size_t SIZE> class OldFixedArray {
+private:
+  T data[SIZE];
+  size_t current_size = 0;
+
+public:
+  void push_back(const T &item) {
+    if (current_size < SIZE) {
+      data[current_size++] = item;
+    } else {
+      throw runtime_error("Array is full!");
+    }
+  }
+
+  size_t size() const { return current_size; }
+  T &operator[](size_t index) { return data[index]; }
+};
+
+// a few names into a FixedArray<string, 1000>, n times
+template <typename Array> size_t few_names(size_t n) {
+  const string names[3] = {"George Washington", "John Adams", "Jefferson"};
+  size_t total = 0;
+  for (size_t i = 0; i < n; ++i) {
+    Array a;
+    for (const string &s : names)
+      a.push_back(s);
+    total += a[a.size() - 1].size();
+  }
+  return total;
+}
+
+void bench_fixed(size_t n) {
+  cout << "=== FixedArray<string, 1000> with 3 names, " << n
+       << " times ===\n";
+  size_t a = 0, b = 0;
+  double old_way =
+      time_ms([&] { a = few_names<OldFixedArray<string, 1000>>(n); });
+  double new_way =
+      time_ms([&] { b = few_names<FixedArray<string, 1000>>(n); });
+  cout << "  every slot constructed: " << old_way
+       << " ms, only the used ones: " << new_way << " ms"
+       << (a == b ? "" : " MISMATCH!") << '\n';
+}
+
+// the chapter18_practice square(), three ways of saying what it was given
+template <typename T> T square_logged(T value, ostream &log) {
+  log << "  Squaring numeric value: " << value << "\n";
+  return value * value;
+}
+template <typename T> T square_traced(T value) {
+  TRACE(trace::detail, trace::templates, "Squaring numeric value: {}", value);
+  return value * value;
+}
+template <typename T> T square_recorded(T value) {
+  trace::write("Squaring numeric value: {}", value);
+  return value * value;
+}
+
+void bench_trace(size_t n) {
+  cout << "=== square() on " << n << " ints with a log line each ===\n";
+  long long a = 0, b = 0, c = 0;
+  ostringstream log; // cout without the terminal
+  double logged = time_ms([&] {
+    for (size_t i = 0; i < n; ++i)
+      a += square_logged(static_cast<long long>(i % 1000), log);
+  });
+  double traced = time_ms([&] {
+    for (size_t i = 0; i < n; ++i)
+      c += square_traced(static_cast<long long>(i % 1000));
+  });
+  // only the recording is timed; the formatter gets to catch up in between
+  // so no records are dropped
+  double recorded = 0;
+  const size_t batch = trace::Ring::capacity / 2;
+  for (size_t done = 0; done < n; done += batch) {
+    size_t stop = min(n, done + batch);
+    recorded += time_ms([&] {
+      for (size_t i = done; i < stop; ++i)
+        b += square_recorded(static_cast<long long>(i % 1000));
+    });
+    trace::Collector::get().flush();
+  }
+  cout << "  ostream: " << logged << " ms, TRACE at level " << TRACE_LEVEL
+       << ": " << traced << " ms, always recorded: " << recorded << " ms"
+       << (a == b && b == c ? "" : " MISMATCH!") << '\n';
+}
+
+// the one-value templates from chapter18_practice.cpp, called in a loop
+template <Numeric T> T square_one(const T &value) { return value * value; }
+template <typename T> T maximum_one(const T &a, const T &b) {
+  return (a > b) ? a : b;
+}
+template <typename T, typename U>
+auto add_one(const T &a, const U &b) -> decltype(a + b) {
+  return a + b;
+}
+
+// prints the two times and how many GB/s of input and output the batch
+// version moved
+void report(const char *what, double loop, double batch, double bytes,
+            bool same) {
+  cout << "  " << what << ": loop " << loop << " ms, batch " << batch
+       << " ms (" << bytes / batch / 1e6 << " GB/s)"
+       << (same ? "" : " MISMATCH!") << '\n';
+}
+
+void bench_batch(size_t n) {
+  cout << "=== " << n << " floats, one at a time vs batch:: ===\n";
+  vector<float> a(n), b(n), out(n), out2(n);
+  vector<int> ints(n);
+  vector<double> mixed(n), mixed2(n);
+  for (size_t i = 0; i < n; ++i) {
+    a[i] = static_cast<float>(i % 1000) / 8;
+    b[i] = static_cast<float>(i % 7);
+    ints[i] = static_cast<int>(i % 5000);
+  }
+  double fb = sizeof(float) * static_cast<double>(n);
+
+  double loop = time_ms([&] {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = square_one(a[i]);
+  });
+  double batch = time_ms([&] { batch::square(a, out2); });
+  report("square", loop, batch, 2 * fb, out == out2);
+
+  float m1 = 0, m2 = 0;
+  loop = time_ms([&] {
+    m1 = a[0];
+    for (size_t i = 1; i < n; ++i)
+      m1 = maximum_one(m1, a[i]);
+  });
+  batch = time_ms([&] { m2 = batch::maximum(a); });
+  report("maximum", loop, batch, fb, m1 == m2);
+
+  // float totals depend on the order they're added in (and a float loop
+  // over millions of values drifts a long way), so the batch totals are
+  // checked against ones kept in double
+  auto close = [](double x, double y) { return abs(x - y) <= 1e-3 * abs(y); };
+  auto off_by = [](const char *which, double loop_total, double batch_total,
+                   double exact_total) {
+    cout << "    " << which << " off by: loop "
+         << 100 * abs(loop_total - exact_total) / exact_total << "%, batch "
+         << 100 * abs(batch_total - exact_total) / exact_total << "%\n";
+  };
+  double exact = 0;
+  for (size_t i = 0; i < n; ++i)
+    exact += a[i];
+  float s1 = 0, s2 = 0;
+  loop = time_ms([&] {
+    for (float v : a)
+      s1 += v;
+  });
+  batch = time_ms([&] { s2 = batch::sum(a); });
+  report("sum", loop, batch, fb, close(s2, exact));
+  off_by("sum", s1, s2, exact);
+
+  exact = 0;
+  for (size_t i = 0; i < n; ++i)
+    exact += static_cast<double>(a[i]) * b[i];
+  float d1 = 0, d2 = 0;
+  loop = time_ms([&] {
+    for (size_t i = 0; i < n; ++i)
+      d1 += a[i] * b[i];
+  });
+  batch = time_ms([&] { d2 = batch::dot(a, b); });
+  report("dot", loop, batch, 2 * fb, close(d2, exact));
+  off_by("dot", d1, d2, exact);
+
+  vector<double> wide(b.begin(), b.end());
+  loop = time_ms([&] {
+    for (size_t i = 0; i < n; ++i)
+      mixed[i] = add_one(ints[i], wide[i]);
+  });
+  batch = time_ms([&] { batch::add(ints, wide, mixed2); });
+  report("int + double", loop, batch,
+         static_cast<double>(n) * (sizeof(int) + 2 * sizeof(double)),
+         mixed == mixed2);
+}
+
+// a * b + c * d the way it goes without expression templates: each
+// operator fills a whole new array, which the next one reads back
+struct EagerCount {
+  size_t arrays = 0;
+  double bytes = 0; // read and written by the operators themselves
+} eager;
+
+template <typename T, typename U, typename Op>
+auto eager_apply(const vector<T> &a, const vector<U> &b, Op op) {
+  vector<decltype(op(a[0], b[0]))> out(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    out[i] = op(a[i], b[i]);
+  ++eager.arrays;
+  eager.bytes += static_cast<double>(a.size()) *
+                 (sizeof(T) + sizeof(U) + sizeof(out[0]));
+  return out;
+}
+template <typename T, typename U, size_t N, typename Op>
+auto eager_apply(const FixedArray<T, N> &a, const FixedArray<U, N> &b,
+                 Op op) {
+  FixedArray<decltype(op(a[0], b[0])), N> out;
+  for (size_t i = 0; i < a.size(); ++i)
+    out.push_back(op(a[i], b[i]));
+  ++eager.arrays;
+  eager.bytes += static_cast<double>(a.size()) *
+                 (sizeof(T) + sizeof(U) + sizeof(out[0]));
+  return out;
+}
+template <typename A, typename B, typename C, typename D>
+auto eager_formula(const A &a, const B &b, const C &c, const D &d) {
+  return eager_apply(eager_apply(a, b, multiplies<>{}),
+                     eager_apply(c, d, multiplies<>{}), plus<>{});
+}
+
+void bench_expr(size_t n) {
+  cout << "=== r = a * b + c * d on " << n
+       << " values (a int, the rest double) ===\n";
+  vector<int> va(n);
+  vector<double> vb(n), vc(n), vd(n);
+  for (size_t i = 0; i < n; ++i) {
+    va[i] = static_cast<int>(i % 100);
+    vb[i] = static_cast<double>(i % 7) / 4;
+    vc[i] = static_cast<double>(i % 13);
+    vd[i] = 0.5;
+  }
+  DynamicArray<int> a(n);
+  DynamicArray<double> b(n), c(n), d(n), r(n);
+  copy(va.begin(), va.end(), a.begin());
+  copy(vb.begin(), vb.end(), b.begin());
+  copy(vc.begin(), vc.end(), c.begin());
+  copy(vd.begin(), vd.end(), d.begin());
+
+  vector<double> slow;
+  eager = {};
+  double eager_ms = time_ms([&] { slow = eager_formula(va, vb, vc, vd); });
+  double fused_ms = time_ms([&] { r = a * b + c * d; });
+  DynamicArray<double> fresh;
+  double fresh_ms = time_ms([&] { fresh = a * b + c * d; });
+  bool same = equal(slow.begin(), slow.end(), r.begin()) &&
+              equal(slow.begin(), slow.end(), fresh.begin());
+
+  // the fused loop reads each input once and writes r once
+  double fused_bytes =
+      static_cast<double>(n) * (sizeof(int) + 4 * sizeof(double));
+  cout << "  an array per operator: " << eager_ms << " ms, "
+       << eager.arrays << " arrays made, " << eager.bytes / 1e6 << " MB moved\n"
+       << "  one loop into r: " << fused_ms << " ms, 0 arrays made, "
+       << fused_bytes / 1e6 << " MB moved\n"
+       << "  one loop into a new array: " << fresh_ms << " ms"
+       << (same ? "" : " MISMATCH!") << '\n';
+
+  // the same on FixedArrays small enough to stay in cache, many times
+  constexpr size_t small = 64;
+  size_t rounds = max<size_t>(1, n / small);
+  FixedArray<int, small> fa;
+  FixedArray<double, small> fb, fc, fd;
+  for (size_t i = 0; i < small; ++i) {
+    fa.push_back(va[i]);
+    fb.push_back(vb[i]);
+    fc.push_back(vc[i]);
+    fd.push_back(vd[i]);
+  }
+  double check1 = 0, check2 = 0;
+  eager = {};
+  eager_ms = time_ms([&] {
+    for (size_t k = 0; k < rounds; ++k)
+      check1 += eager_formula(fa, fb, fc, fd)[k % small];
+  });
+  size_t eager_arrays = eager.arrays;
+  fused_ms = time_ms([&] {
+    for (size_t k = 0; k < rounds; ++k) {
+      FixedArray<double, small> fr = fa * fb + fc * fd;
+      check2 += fr[k % small];
+    }
+  });
+  cout << "  FixedArray<_, " << small << "> " << rounds
+       << " times: an array per operator " << eager_ms << " ms ("
+       << eager_arrays << " arrays), one loop " << fused_ms << " ms"
+       << (check1 == check2 ? "" : " MISMATCH!") << '\n';
+}
+
+int main(int argc, char *argv[]) {
+  string section = argc > 1 ? argv[1] : "all";
+  size_t n = argc > 2 ? stoul(argv[2]) : 1000000;
+
+  if (section == "all" || section == "fixed")
+    bench_fixed(n);
+  if (section == "all" || section == "trace")
+    bench_trace(n);
+  if (section == "all" || section == "batch")
+    bench_batch(n * 16);
+  if (section == "all" || section == "expr")
+    bench_expr(n * 4);
+
+  return 0;
+}
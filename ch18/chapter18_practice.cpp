@@ -1,5 +1,9 @@
 // ch18 code
 
+#include "../trace.h"
+#include "array_expr.h"
+#include "batch_math.h"
+#include "fixed_array.h"
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -15,51 +19,44 @@ using namespace std;
 
 // Basic function template
 template <typename T> T maximum(const T &a, const T &b) {
-  cout << "  Comparing values of type: " << typeid(T).name() << "\n";
+  TRACE(trace::detail, trace::templates, "Comparing values of type: {}",
+        trace::Literal{typeid(T).name()});
   return (a > b) ? a : b;
 }
 
 // Template with multiple parameters
 template <typename T, typename U>
 auto add_different_types(const T &a, const U &b) -> decltype(a + b) {
-  cout << "  Adding " << typeid(T).name() << " and " << typeid(U).name()
-       << "\n";
+  TRACE(trace::detail, trace::templates, "Adding {} and {}",
+        trace::Literal{typeid(T).name()}, trace::Literal{typeid(U).name()});
   return a + b;
 }
 
-// Template with non-type parameter
-template <typename T, size_t SIZE> class FixedArray {
-private:
-  T data[SIZE];
-  size_t current_size = 0;
-
-public:
-  void push_back(const T &item) {
-    if (current_size < SIZE) {
-      data[current_size++] = item;
-    } else {
-      throw runtime_error("Array is full!");
-    }
-  }
-
-  size_t size() const { return current_size; }
-  size_t capacity() const { return SIZE; }
-
-  T &operator[](size_t index) { return data[index]; }
-  const T &operator[](size_t index) const { return data[index]; }
-};
+// Template with non-type parameter: FixedArray<T, SIZE> (fixed_array.h)
+// keeps room for SIZE values inside itself and constructs each one only
+// when it is added. a FixedArray of ints even works at compile time:
+constexpr int sum_of_squares_after_first(int n) {
+  FixedArray<int, 16> squares;
+  for (int i = 1; i <= n; ++i)
+    squares.push_back(i * i);
+  squares.erase(squares.begin());
+  int total = 0;
+  for (int v : squares)
+    total += v;
+  return total;
+}
+static_assert(sum_of_squares_after_first(3) == 4 + 9);
 
 // ============================================================================
 // CONCEPTS DEMONSTRATION (C++20 - may not compile on older compilers)
 // ============================================================================
 
-// Simple concept definition
-template <typename T>
-concept Numeric = std::is_arithmetic_v<T>;
-
+// Simple concept definition: Numeric is in numeric.h. batch_math.h has
+// square, maximum, add and friends for whole arrays at once, and
+// array_expr.h gives FixedArray + - * / that run in a single loop
 // Function using concept
 template <Numeric T> T square(const T &value) {
-  cout << "  Squaring numeric value: " << value << "\n";
+  TRACE(trace::detail, trace::templates, "Squaring numeric value: {}", value);
   return value * value;
 }
 
@@ -67,7 +64,8 @@ template <Numeric T> T square(const T &value) {
 template <typename T>
 typename std::enable_if_t<std::is_arithmetic_v<T>, T>
 square_old_style(const T &value) {
-  cout << "  Squaring (old style) numeric value: " << value << "\n";
+  TRACE(trace::detail, trace::templates,
+        "Squaring (old style) numeric value: {}", value);
   return value * value;
 }
 
@@ -404,6 +402,16 @@ int main() {
     cout << "  FixedArray size: " << arr.size() << "/" << arr.capacity()
          << "\n";
 
+    // only the strings added are ever constructed, not all 100
+    FixedArray<string, 100> names;
+    names.emplace_back(5, 'x'); // built in place as string(5, 'x')
+    string moved = "moved in";
+    names.push_back(std::move(moved));
+    names.insert(names.begin(), "erased");
+    names.erase(names.begin());
+    cout << "  FixedArray<string, 100> holds " << names.size() << ": "
+         << names.front() << ", " << names.back() << "\n";
+
     // Concepts demonstration (if C++20 available)
     cout << "\n=== CONCEPTS DEMO ===\n";
     try {
@@ -411,6 +419,27 @@ int main() {
       cout << "  square(5) = " << square_old_style(5) << "\n";
       cout << "  square(3.14) = " << square_old_style(3.14) << "\n";
       // square("hello"); // Would not compile with concepts
+
+      // the same ideas on a whole array: batch:: works through several
+      // values per instruction
+      vector<int> ints = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3};
+      vector<double> halves(ints.size(), 0.5);
+      vector<double> mixed(ints.size());
+      batch::add(ints, halves, mixed); // int + double is double
+      batch::square(ints, ints);
+      cout << "  sum of squares = " << batch::sum(ints)
+           << ", biggest = " << batch::maximum(ints)
+           << ", first mixed sum = " << mixed[0] << "\n";
+
+      // a whole formula in one pass, no array in between; int * double
+      // gives doubles, like add_different_types
+      FixedArray<int, 5> counts = {1, 2, 3, 4, 5};
+      FixedArray<double, 5> prices = {0.5, 1.25, 2, 4, 8};
+      FixedArray<double, 5> totals = counts * prices + 0.25;
+      cout << "  counts * prices + 0.25 = ";
+      for (double t : totals)
+        cout << t << " ";
+      cout << "\n";
     } catch (...) {
       cout << "Concepts may not be available on this compiler\n";
     }
@@ -0,0 +1,168 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * FixedArray: a vector with its room for SIZE values built into it and no
+ * heap at all. the room starts out empty, and a value is only constructed
+ * when it is added, so a FixedArray<string, 1000> holding 3 names pays for
+ * 3 strings, not 1000. for simple types like int it works at compile time
+ * too.
+ */
+
+#include "../connor.h"
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace fixed_array {
+
+// the room for the values. for types with real constructors it is a union,
+// so nothing in it is constructed until the FixedArray says so; simple
+// types just get a plain array, which is what compile time needs.
+template <typename T, size_t SIZE,
+          bool Simple = is_trivially_default_constructible_v<T> &&
+                        is_trivially_destructible_v<T>>
+struct Storage {
+  constexpr Storage() {}
+  constexpr ~Storage() {}
+  union {
+    T items[SIZE];
+  };
+};
+
+template <typename T, size_t SIZE> struct Storage<T, SIZE, true> {
+  T items[SIZE];
+};
+
+} // namespace fixed_array
+
+template <typename T, size_t SIZE> class FixedArray {
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  constexpr FixedArray() = default;
+  constexpr FixedArray(initializer_list<T> values) {
+    for (const T &v : values)
+      push_back(v);
+  }
+  constexpr FixedArray(const FixedArray &other) {
+    for (const T &v : other)
+      push_back(v);
+  }
+  constexpr FixedArray(FixedArray &&other) noexcept(
+      is_nothrow_move_constructible_v<T>) {
+    for (T &v : other)
+      emplace_back(std::move(v));
+    other.clear();
+  }
+  constexpr FixedArray &operator=(const FixedArray &other) {
+    if (this != &other) {
+      clear();
+      for (const T &v : other)
+        push_back(v);
+    }
+    return *this;
+  }
+  constexpr FixedArray &operator=(FixedArray &&other) noexcept(
+      is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      clear();
+      for (T &v : other)
+        emplace_back(std::move(v));
+      other.clear();
+    }
+    return *this;
+  }
+  constexpr ~FixedArray() { clear(); }
+
+  constexpr size_t size() const { return current_size; }
+  constexpr size_t capacity() const { return SIZE; }
+  constexpr bool empty() const { return current_size == 0; }
+  constexpr bool full() const { return current_size == SIZE; }
+
+  constexpr T *data() { return storage.items; }
+  constexpr const T *data() const { return storage.items; }
+  constexpr T &operator[](size_t index) { return data()[index]; }
+  constexpr const T &operator[](size_t index) const { return data()[index]; }
+  constexpr T &at(size_t index) {
+    if (index >= current_size)
+      throw out_of_range("FixedArray index out of range");
+    return data()[index];
+  }
+  constexpr const T &at(size_t index) const {
+    return const_cast<FixedArray *>(this)->at(index);
+  }
+  constexpr T &front() { return data()[0]; }
+  constexpr const T &front() const { return data()[0]; }
+  constexpr T &back() { return data()[current_size - 1]; }
+  constexpr const T &back() const { return data()[current_size - 1]; }
+
+  constexpr iterator begin() { return data(); }
+  constexpr iterator end() { return data() + current_size; }
+  constexpr const_iterator begin() const { return data(); }
+  constexpr const_iterator end() const { return data() + current_size; }
+
+  // builds the new value right in its slot
+  template <typename... Args> constexpr T &emplace_back(Args &&...args) {
+    if (full())
+      throw runtime_error("Array is full!");
+    T *slot = construct_at(data() + current_size, std::forward<Args>(args)...);
+    ++current_size;
+    return *slot;
+  }
+  constexpr void push_back(const T &item) { emplace_back(item); }
+  constexpr void push_back(T &&item) { emplace_back(std::move(item)); }
+  constexpr void pop_back() { destroy_at(data() + --current_size); }
+
+  // puts a value made from args before pos; returns its position
+  template <typename... Args>
+  constexpr iterator emplace(const_iterator pos, Args &&...args) {
+    size_t at = static_cast<size_t>(pos - begin());
+    emplace_back(std::forward<Args>(args)...);
+    rotate(begin() + at, end() - 1, end());
+    return begin() + at;
+  }
+  constexpr iterator insert(const_iterator pos, const T &item) {
+    return emplace(pos, item);
+  }
+  constexpr iterator insert(const_iterator pos, T &&item) {
+    return emplace(pos, std::move(item));
+  }
+
+  // removes the value at pos; returns the position of the one after it
+  constexpr iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  constexpr iterator erase(const_iterator first, const_iterator last) {
+    iterator f = begin() + (first - begin());
+    iterator new_end = std::move(begin() + (last - begin()), end(), f);
+    while (end() != new_end)
+      pop_back();
+    return f;
+  }
+
+  constexpr void clear() {
+    while (current_size > 0)
+      pop_back();
+  }
+
+  // shrinks to n values, or grows to n with T{} for the new ones
+  constexpr void resize(size_t n) {
+    while (current_size > n)
+      pop_back();
+    while (current_size < n)
+      emplace_back();
+  }
+
+private:
+  fixed_array::Storage<T, SIZE> storage;
+  size_t current_size = 0;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * the concept the ch18 number templates share
+ */
+
+#include <type_traits>
+
+// any built-in number type
+template <typename T>
+concept Numeric = std::is_arithmetic_v<T>;
@@ -0,0 +1,240 @@
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * timings for the ch19 insert and erase patterns on bigger containers
+ * usage: ch19_bench [section] [number of values]
+ */
+
+#include "../connor.h"
+#include "../small_vector.h"
+#include "gap_buffer.h"
+#include "hive.h"
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+// every plain new and delete in the program goes through these, so a
+// section can count how often it went to the heap
+size_t allocations = 0;
+
+void *operator new(size_t size) {
+  ++allocations;
+  if (void *p = malloc(size ? size : 1))
+    return p;
+  throw bad_alloc();
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+template <typename F> double time_ms(F &&f) {
+  auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+// one edit at a cursor: step it forward or back a little, then insert or
+// erase there, the way ch19_hw.cc does with vit and lit
+struct Edit {
+  int step;
+  bool insert;
+};
+
+vector<Edit> cursor_edits(size_t count, uint64_t seed) {
+  mt19937_64 rng(seed);
+  vector<Edit> edits(count);
+  for (Edit &e : edits)
+    e = {static_cast<int>(rng() % 17) - 8, rng() % 2 == 0};
+  return edits;
+}
+
+// runs edits on any container with vector/list style insert and erase,
+// starting at the middle
+template <typename C> void apply_edits(C &c, const vector<Edit> &edits) {
+  auto it = c.begin();
+  advance(it, c.size() / 2);
+  for (const Edit &e : edits) {
+    for (int k = 0; k < e.step && it != c.end(); ++k)
+      ++it;
+    for (int k = 0; k > e.step && it != c.begin(); --k)
+      --it;
+    if (e.insert)
+      it = c.insert(it, "edit");
+    else if (it != c.end())
+      it = c.erase(it);
+  }
+}
+
+template <typename C> size_t total_length(const C &c) {
+  size_t total = 0;
+  for (const string &s : c)
+    total += s.size();
+  return total;
+}
+
+void bench_gap(size_t n) {
+  cout << "=== vector vs list vs GapBuffer, edits at a cursor, " << n
+       << " values ===\n";
+  vector<string> start;
+  for (size_t i = 0; i < n; ++i)
+    start.push_back("president " + to_string(i));
+
+  // every vector edit shifts half the vector, so it only does 1% of them
+  const size_t edits = n;
+  vector<Edit> all = cursor_edits(edits, 19);
+  vector<Edit> some(all.begin(), all.begin() + edits / 100);
+
+  vector<string> vec = start;
+  list<string> lst(start.begin(), start.end());
+  GapBuffer<string> gap(start.begin(), start.end());
+  GapBuffer<string> gap_some = gap;
+
+  double t_vec = time_ms([&] { apply_edits(vec, some); });
+  double t_list = time_ms([&] { apply_edits(lst, all); });
+  double t_gap = time_ms([&] { apply_edits(gap, all); });
+  apply_edits(gap_some, some);
+  bool same =
+      equal(vec.begin(), vec.end(), gap_some.begin(), gap_some.end()) &&
+      equal(lst.begin(), lst.end(), gap.begin(), gap.end());
+
+  size_t a = 0, b = 0, c = 0;
+  double walk_vec = time_ms([&] { a = total_length(vec); });
+  double walk_list = time_ms([&] { b = total_length(lst); });
+  double walk_gap = time_ms([&] { c = total_length(gap); });
+  same = same && a == total_length(gap_some) && b == c;
+
+  cout << "  microseconds per edit: vector " << t_vec * 1000 / some.size()
+       << ", list " << t_list * 1000 / edits << ", GapBuffer "
+       << t_gap * 1000 / edits << '\n';
+  cout << "  walk: vector " << walk_vec << " ms, list " << walk_list
+       << " ms, GapBuffer " << walk_gap << " ms"
+       << (same ? "" : " MISMATCH!") << '\n';
+}
+
+void bench_hive(size_t n) {
+  cout << "=== list vs Hive, erase and insert while walking, " << n
+       << " values ===\n";
+  vector<string> start;
+  for (size_t i = 0; i < n; ++i)
+    start.push_back("president " + to_string(i));
+
+  // one round: erase every value whose number ends in the round's digit,
+  // then put as many new ones back
+  auto churn = [&](auto &c) {
+    for (char digit = '0'; digit < '5'; ++digit) {
+      size_t gone = 0;
+      for (auto it = c.begin(); it != c.end();) {
+        if (it->back() == digit) {
+          it = c.erase(it);
+          ++gone;
+        } else {
+          ++it;
+        }
+      }
+      for (size_t i = 0; i < gone; ++i)
+        c.insert(c.end(), "new " + to_string(i) + digit);
+    }
+  };
+
+  list<string> lst;
+  Hive<string> hive;
+  double build_list = time_ms([&] { lst.assign(start.begin(), start.end()); });
+  double build_hive = time_ms([&] {
+    for (const string &s : start)
+      hive.insert(s);
+  });
+  double churn_list = time_ms([&] { churn(lst); });
+  double churn_hive = time_ms([&] { churn(hive); });
+
+  size_t a = 0, b = 0;
+  double walk_list = time_ms([&] { a = total_length(lst); });
+  double walk_hive = time_ms([&] { b = total_length(hive); });
+  vector<string> x(lst.begin(), lst.end()), y(hive.begin(), hive.end());
+  sort(x.begin(), x.end());
+  sort(y.begin(), y.end());
+  bool same = a == b && x == y;
+
+  cout << "  build: list " << build_list << " ms, Hive " << build_hive
+       << " ms\n";
+  cout << "  5 rounds of erase and insert: list " << churn_list
+       << " ms, Hive " << churn_hive << " ms\n";
+  cout << "  walk: list " << walk_list << " ms, Hive " << walk_hive << " ms"
+       << (same ? "" : " MISMATCH!") << '\n';
+}
+
+// the ch19_book.cpp steps, reps times: 7 ints into a vector, insert 99 in
+// front of the 4th, erase it again
+template <typename Vec> size_t book_steps(size_t reps) {
+  const int initializer[7] = {1, 2, 3, 4, 5, 6, 7};
+  size_t sum = 0;
+  for (size_t r = 0; r < reps; ++r) {
+    Vec v(initializer, initializer + 7);
+    auto p = v.begin() + 3;
+    p = v.insert(p, 99);
+    p = v.erase(p);
+    sum += static_cast<size_t>(*p + v.back());
+  }
+  return sum;
+}
+
+// the ch19_hw.cc presidents: 10 names, one inserted and erased again
+template <typename Vec> size_t president_steps(size_t reps) {
+  size_t sum = 0;
+  for (size_t r = 0; r < reps; ++r) {
+    Vec v = {"Washington", "Jefferson", "Lincoln", "T. Roosevelt",
+             "F. Roosevelt", "Jackson", "Garfield", "Taylor", "Monroe",
+             "Polk"};
+    auto it = v.insert(v.begin() + 1, "Adams");
+    it = v.erase(it);
+    sum += it->size() + v.size();
+  }
+  return sum;
+}
+
+void bench_small(size_t n) {
+  cout << "=== vector vs SmallVector, the homework's short vectors, " << n
+       << " times ===\n";
+  size_t a = 0, b = 0;
+  size_t before = allocations;
+  double t_vec = time_ms([&] { a = book_steps<vector<int>>(n); });
+  size_t vec_allocs = allocations - before;
+  before = allocations;
+  double t_small = time_ms([&] { b = book_steps<SmallVector<int, 8>>(n); });
+  size_t small_allocs = allocations - before;
+  cout << "  7 ints: vector " << t_vec << " ms, "
+       << double(vec_allocs) / n << " allocations each; SmallVector "
+       << t_small << " ms, " << double(small_allocs) / n
+       << " allocations each" << (a == b ? "" : " MISMATCH!") << '\n';
+
+  // the names are short enough for string to keep them inline too, so any
+  // allocation left is the vector's own
+  size_t reps = n / 10;
+  before = allocations;
+  t_vec = time_ms([&] { a = president_steps<vector<string>>(reps); });
+  vec_allocs = allocations - before;
+  before = allocations;
+  t_small =
+      time_ms([&] { b = president_steps<SmallVector<string, 16>>(reps); });
+  small_allocs = allocations - before;
+  cout << "  10 presidents: vector " << t_vec << " ms, "
+       << double(vec_allocs) / reps << " allocations each; SmallVector "
+       << t_small << " ms, " << double(small_allocs) / reps
+       << " allocations each" << (a == b ? "" : " MISMATCH!") << '\n';
+}
+
+int main(int argc, char *argv[]) {
+  string section = argc > 1 ? argv[1] : "all";
+  size_t n = argc > 2 ? stoul(argv[2]) : 1000000;
+
+  if (section == "all" || section == "gap")
+    bench_gap(n);
+  if (section == "all" || section == "hive")
+    bench_hive(n);
+  if (section == "all" || section == "small")
+    bench_small(n);
+
+  return 0;
+}
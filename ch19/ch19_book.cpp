@@ -9,6 +9,7 @@
  */
 
 #include "../connor.h"
+#include "../small_vector.h"
 
 int main() {
 
@@ -16,14 +17,15 @@ int main() {
   int *first = initializer;
   int *last = initializer + 7;
 
-  // compare using vector
+  // compare using vector (one that keeps up to 8 ints inside itself, so
+  // these 7 never touch the heap)
   {
-    vector<int> v(first, last);
-    vector<int>::iterator p = v.begin(); // take a vector
+    SmallVector<int, 8> v(first, last);
+    SmallVector<int, 8>::iterator p = v.begin(); // take a vector
     ++p;
     ++p;
     ++p; // point to its 4th element (index 3)
-    vector<int>::iterator q = p;
+    SmallVector<int, 8>::iterator q = p;
     ++q; // point to its 5th element (index 4)
 
     p = v.insert(p, 99);
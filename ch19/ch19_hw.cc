@@ -9,14 +9,21 @@
  */
 
 #include "../connor.h"
+#include "../small_vector.h"
+#include "gap_buffer.h"
+#include "hive.h"
 
-void print_vector(const vector<string> &v) {
+// room for the 10 presidents and a few more without going to the heap
+using Presidents = SmallVector<string, 16>;
+
+void print_vector(const Presidents &v) {
   cout << "vector contents: \n";
   for (const auto &name : v)
     cout << " - " << name << "\n";
 }
 
-void print_list(const list<string> &l) {
+// any container of names that can be walked in order: list or Hive
+template <typename List> void print_list(const List &l) {
   cout << "list contents: \n";
   for (const auto &name : l)
     cout << " - " << name << "\n";
@@ -24,15 +31,15 @@ void print_list(const list<string> &l) {
 
 int main() {
   // sample data: former us presidents
-  vector<string> presidents = {"George Washington",     "Thomas Jefferson",
-                               "Abraham Lincoln",       "Theodore Roosevelt",
-                               "Franklin D. Roosevelt", "Andrew Jackson",
-                               "James Garfield",        "Zachary Taylor",
-                               "James Monroe",          "James Polk"};
+  Presidents presidents = {"George Washington",     "Thomas Jefferson",
+                           "Abraham Lincoln",       "Theodore Roosevelt",
+                           "Franklin D. Roosevelt", "Andrew Jackson",
+                           "James Garfield",        "Zachary Taylor",
+                           "James Monroe",          "James Polk"};
 
   // vector operations
   cout << "=== VECTOR DEMONSTRATION ===\n";
-  vector<string>::iterator vit = presidents.begin();
+  Presidents::iterator vit = presidents.begin();
   ++vit; // move to 2nd element ("Thomas Jefferson")
 
   // insert a president before the 2nd element
@@ -59,5 +66,32 @@ int main() {
   // traveerse and print
   print_list(pres_list);
 
+  // gap buffer operations: the same cursor moves as the vector, but the
+  // insert and erase only move the values between the gap and the cursor
+  cout << "\n=== GAP BUFFER DEMONSTRATION ===\n";
+  GapBuffer<string> pres_gap(presidents.begin(), presidents.end());
+  GapBuffer<string>::iterator git = pres_gap.begin();
+  ++git; // move to 2nd element
+
+  git = pres_gap.insert(git, "John Adams");
+  git = pres_gap.erase(git);
+
+  cout << "gap buffer contents: \n";
+  for (const auto &name : pres_gap)
+    cout << " - " << name << "\n";
+
+  // hive operations: like the list, an iterator stays good while other
+  // names go in and out, but the hive picks where a new name goes
+  cout << "\n=== HIVE DEMONSTRATION ===\n";
+  Hive<string> pres_hive(presidents.begin(), presidents.end());
+  Hive<string>::iterator hit = pres_hive.begin();
+  advance(hit, 2); // move to 3rd element
+
+  Hive<string>::iterator madison = pres_hive.insert("James Madison");
+  pres_hive.erase(madison);
+  cout << "still pointing at " << *hit << "\n";
+
+  print_list(pres_hive);
+
   return 0;
 };
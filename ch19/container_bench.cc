@@ -0,0 +1,154 @@
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * the ch19 insert and erase, measured properly: every container, element
+ * type, size and place in the container, with the cpu's counters next to
+ * the time. writes one CSV row per case so runs can be compared later.
+ * usage: container_bench [csv file, - for the screen] [largest size]
+ */
+
+#include "../connor.h"
+#include "../small_vector.h"
+#include "gap_buffer.h"
+#include "perf_counters.h"
+#include <chrono>
+#include <deque>
+#include <random>
+
+enum class Where { front, middle, back, random };
+const char *where_name(Where w) {
+  switch (w) {
+  case Where::front:
+    return "front";
+  case Where::middle:
+    return "middle";
+  case Where::back:
+    return "back";
+  default:
+    return "random";
+  }
+}
+
+template <typename T> T make_value(size_t i);
+template <> int make_value<int>(size_t i) { return static_cast<int>(i); }
+template <> string make_value<string>(size_t i) {
+  return "president " + to_string(i);
+}
+
+struct Result {
+  double ns_per_op;
+  PerfCounters::Reading counts;
+};
+
+// ops rounds of: insert a value at the chosen place, then erase the value
+// there, so the size stays n. the place is found from begin() every time,
+// the way code without a saved iterator has to, which is what makes the
+// middle and random cases slow for list.
+template <typename C>
+Result insert_erase(PerfCounters &perf, size_t n, Where where, size_t ops) {
+  using T = typename C::value_type;
+  C c;
+  for (size_t i = 0; i < n; ++i)
+    c.insert(c.end(), make_value<T>(i));
+
+  mt19937_64 rng(46);
+  vector<size_t> places(ops);
+  for (size_t &p : places) {
+    switch (where) {
+    case Where::front:
+      p = 0;
+      break;
+    case Where::middle:
+      p = n / 2;
+      break;
+    case Where::back:
+      p = n;
+      break;
+    case Where::random:
+      p = rng() % (n + 1);
+      break;
+    }
+  }
+  const T v = make_value<T>(n);
+
+  perf.start();
+  auto start = chrono::steady_clock::now();
+  for (size_t p : places) {
+    auto it = c.insert(next(c.begin(), static_cast<ptrdiff_t>(p)), v);
+    c.erase(it);
+  }
+  double ns = chrono::duration<double, nano>(chrono::steady_clock::now() -
+                                             start).count();
+  Result r{ns / static_cast<double>(ops), perf.stop()};
+  if (c.size() != n)
+    r.ns_per_op = -1; // flags a broken container in the CSV
+  return r;
+}
+
+template <typename C>
+void run_container(ostream &csv, PerfCounters &perf, const string &name,
+                   const string &type, const vector<size_t> &sizes) {
+  for (size_t n : sizes) {
+    for (Where w : {Where::front, Where::middle, Where::back, Where::random}) {
+      // enough rounds to time, but the O(n) cases don't take all day
+      size_t ops = max<size_t>(100, 2000000 / (n + 1));
+      Result r = insert_erase<C>(perf, n, w, ops);
+      csv << name << ',' << type << ',' << where_name(w) << ',' << n << ','
+          << ops << ',' << r.ns_per_op;
+      for (const optional<uint64_t> &count : r.counts) {
+        csv << ',';
+        if (count)
+          csv << static_cast<double>(*count) / static_cast<double>(ops);
+      }
+      csv << '\n';
+    }
+  }
+}
+
+template <typename T>
+void run_type(ostream &csv, PerfCounters &perf, const string &type,
+              const vector<size_t> &sizes) {
+  run_container<vector<T>>(csv, perf, "vector", type, sizes);
+  run_container<list<T>>(csv, perf, "list", type, sizes);
+  run_container<deque<T>>(csv, perf, "deque", type, sizes);
+  run_container<GapBuffer<T>>(csv, perf, "GapBuffer", type, sizes);
+  run_container<SmallVector<T, 16>>(csv, perf, "SmallVector16", type, sizes);
+}
+
+int main(int argc, char *argv[]) {
+  string out = argc > 1 ? argv[1] : "-";
+  size_t largest = argc > 2 ? stoul(argv[2]) : 65536;
+
+  ofstream file;
+  if (out != "-") {
+    file.open(out);
+    if (!file) {
+      cerr << "can't write " << out << '\n';
+      return 1;
+    }
+  }
+  ostream &csv = out == "-" ? cout : file;
+
+  PerfCounters perf;
+  for (int e = 0; e < PerfCounters::events; ++e) {
+    auto event = static_cast<PerfCounters::Event>(e);
+    if (!perf.available(event))
+      cerr << "no " << PerfCounters::names[e] << " counter ("
+           << perf.why_not(event) << "); that column stays empty\n";
+  }
+
+  vector<size_t> sizes;
+  for (size_t n = 16; n <= largest; n *= 16)
+    sizes.push_back(n);
+
+  // counts are per insert+erase pair, like the time
+  csv << "container,type,position,size,ops,ns_per_op";
+  for (const char *name : PerfCounters::names)
+    csv << ',' << name;
+  csv << '\n';
+  run_type<int>(csv, perf, "int", sizes);
+  run_type<string>(csv, perf, "string", sizes);
+  return 0;
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * GapBuffer: a sequence like vector, but with an empty stretch (the gap)
+ * kept wherever the last insert or erase happened. inserting or erasing
+ * there only uses up or widens the gap, so edits that stay near one cursor
+ * don't shift the rest of the values, and a walk still reads at most two
+ * runs of memory.
+ */
+
+#include "../connor.h"
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+template <typename T> class GapBuffer {
+public:
+  using value_type = T;
+
+  // a position in the buffer. like vector's iterators, every insert or
+  // erase invalidates them except the one it returns.
+  template <bool Const> class Iterator {
+  public:
+    using iterator_category = random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = conditional_t<Const, const T *, T *>;
+    using reference = conditional_t<Const, const T &, T &>;
+
+    Iterator() = default;
+    template <bool C = Const, typename = enable_if_t<C>>
+    Iterator(const Iterator<false> &other) : p{other.p}, buf{other.buf} {}
+
+    reference operator*() const { return *p; }
+    pointer operator->() const { return p; }
+    reference operator[](difference_type k) const { return *(*this + k); }
+
+    // stepping onto the gap jumps over it
+    Iterator &operator++() {
+      if (++p == buf->gap_begin())
+        p = buf->gap_end();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator old = *this;
+      ++*this;
+      return old;
+    }
+    Iterator &operator--() {
+      if (p == buf->gap_end())
+        p = buf->gap_begin();
+      --p;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    Iterator &operator+=(difference_type k) {
+      p = buf->at_index(index() + static_cast<size_t>(k));
+      return *this;
+    }
+    Iterator &operator-=(difference_type k) { return *this += -k; }
+    Iterator operator+(difference_type k) const {
+      return Iterator{*this} += k;
+    }
+    Iterator operator-(difference_type k) const {
+      return Iterator{*this} -= k;
+    }
+    friend Iterator operator+(difference_type k, const Iterator &it) {
+      return it + k;
+    }
+    difference_type operator-(const Iterator &o) const {
+      return static_cast<difference_type>(index()) -
+             static_cast<difference_type>(o.index());
+    }
+
+    bool operator==(const Iterator &o) const { return p == o.p; }
+    auto operator<=>(const Iterator &o) const { return p <=> o.p; }
+
+  private:
+    friend class GapBuffer;
+    friend class Iterator<!Const>;
+    using Buffer = conditional_t<Const, const GapBuffer, GapBuffer>;
+    Iterator(pointer p, Buffer *buf) : p{p}, buf{buf} {}
+
+    // how many values come before this one
+    size_t index() const {
+      size_t i = static_cast<size_t>(p - buf->store.data());
+      return p >= buf->gap_end() ? i - buf->gap_size() : i;
+    }
+
+    pointer p = nullptr;
+    Buffer *buf = nullptr;
+  };
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  GapBuffer() = default;
+  GapBuffer(initializer_list<T> values)
+      : GapBuffer(values.begin(), values.end()) {}
+  template <typename It> GapBuffer(It first, It last) {
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+
+  size_t size() const { return store.size() - gap_size(); }
+  bool empty() const { return size() == 0; }
+
+  T &operator[](size_t i) { return *at_index(i); }
+  const T &operator[](size_t i) const { return *at_index(i); }
+
+  iterator begin() { return {at_index(0), this}; }
+  iterator end() { return {store.data() + store.size(), this}; }
+  const_iterator begin() const { return {at_index(0), this}; }
+  const_iterator end() const { return {store.data() + store.size(), this}; }
+
+  T &front() { return *begin(); }
+  T &back() { return *--end(); }
+
+  // puts v before pos, like vector's insert; returns v's position
+  template <typename V> iterator insert(const_iterator pos, V &&v) {
+    T value(std::forward<V>(v)); // v may be in here, and about to move
+    move_gap(pos.index());
+    if (gap_size() == 0)
+      grow();
+    T *at = gap_begin();
+    *at = std::move(value);
+    ++gap_start;
+    return {at, this};
+  }
+
+  // removes the value at pos; returns the position of the one after it
+  iterator erase(const_iterator pos) {
+    move_gap(pos.index());
+    *gap_end() = T{}; // let go of what it held
+    ++gap_stop;
+    return {gap_end(), this};
+  }
+
+  void push_back(const T &v) { insert(end(), v); }
+  void push_front(const T &v) { insert(begin(), v); }
+  void pop_back() { erase(--end()); }
+
+  void clear() {
+    store.clear();
+    gap_start = gap_stop = 0;
+  }
+
+private:
+  T *gap_begin() { return store.data() + gap_start; }
+  T *gap_end() { return store.data() + gap_stop; }
+  const T *gap_begin() const { return store.data() + gap_start; }
+  const T *gap_end() const { return store.data() + gap_stop; }
+  size_t gap_size() const { return gap_stop - gap_start; }
+
+  // where the i'th value sits (the end for i == size())
+  T *at_index(size_t i) {
+    return const_cast<T *>(as_const(*this).at_index(i));
+  }
+  const T *at_index(size_t i) const {
+    if (i < gap_start)
+      return store.data() + i;
+    // the gap at the very end means i == size() is the end, not gap_begin()
+    return store.data() + i + gap_size();
+  }
+
+  // slides the gap so it starts in front of the i'th value. only the
+  // values between the old and new place move.
+  void move_gap(size_t i) {
+    if (gap_size() == 0) {
+      gap_start = gap_stop = i; // nothing to move, and moving onto itself
+      return;                   // would empty a string
+    }
+    if (i < gap_start) {
+      move_backward(store.begin() + i, store.begin() + gap_start,
+                    store.begin() + gap_stop);
+      gap_stop -= gap_start - i;
+    } else if (i > gap_start) {
+      size_t k = i - gap_start;
+      move(store.begin() + gap_stop, store.begin() + gap_stop + k,
+           store.begin() + gap_start);
+      gap_stop += k;
+    }
+    gap_start = i;
+  }
+
+  // doubles the room; the values after the gap move to the new end
+  void grow() {
+    size_t after = store.size() - gap_stop;
+    size_t room = max<size_t>(16, store.size());
+    store.resize(store.size() + room);
+    move_backward(store.end() - room - after, store.end() - room,
+                  store.end());
+    gap_stop += room;
+  }
+
+  vector<T> store;      // the values, with the gap somewhere in the middle
+  size_t gap_start = 0; // the gap is store[gap_start, gap_stop)
+  size_t gap_stop = 0;
+};
@@ -0,0 +1,279 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * Hive: a bag of values that never move once they are in. values live in
+ * blocks of slots that grow as the hive does; erasing a value just marks
+ * its slot empty, and the next insert fills an empty slot before it
+ * makes a new one. so like list, insert and erase never invalidate an
+ * iterator to another value, but a walk reads whole blocks in a row
+ * instead of one heap node per value.
+ */
+
+#include "../connor.h"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename T> class Hive {
+  static constexpr size_t first_block = 8;
+  static constexpr size_t max_block = 8192; // indexes fit in uint16_t
+  static constexpr uint16_t none = UINT16_MAX;
+
+  // a value while in use. the first slot of a run of empty slots holds the
+  // links of its block's list of runs instead.
+  union Slot {
+    Slot() {}
+    ~Slot() {}
+    T value;
+    struct {
+      uint16_t prev, succ;
+    } run;
+  };
+
+  // skip[i] is 0 for a slot holding a value. a run of k empty slots has k
+  // in its first and last skip entries, so a walk hops a whole run in
+  // either direction with one read (a jump-counting skip field).
+  struct Block {
+    explicit Block(size_t cap)
+        : slots{make_unique<Slot[]>(cap)},
+          skip{make_unique<uint16_t[]>(cap + 1)}, cap{cap} {}
+    unique_ptr<Slot[]> slots;
+    unique_ptr<uint16_t[]> skip; // one extra 0 past the end stops a walk
+    size_t cap;
+    size_t used = 0;  // slots handed out so far, full or emptied
+    size_t count = 0; // values in the block
+    uint16_t runs = none; // first slot of the first run of empty slots
+    Block *prev = nullptr, *succ = nullptr;           // all the blocks
+    Block *prev_open = nullptr, *succ_open = nullptr; // blocks with runs
+  };
+
+public:
+  using value_type = T;
+
+  template <bool Const> class Iterator {
+  public:
+    using iterator_category = bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = conditional_t<Const, const T *, T *>;
+    using reference = conditional_t<Const, const T &, T &>;
+
+    Iterator() = default;
+    template <bool C = Const, typename = enable_if_t<C>>
+    Iterator(const Iterator<false> &other) : b{other.b}, i{other.i} {}
+
+    reference operator*() const { return b->slots[i].value; }
+    pointer operator->() const { return &b->slots[i].value; }
+
+    Iterator &operator++() {
+      ++i;
+      i += b->skip[i];
+      if (i == b->used && b->succ) {
+        b = b->succ;
+        i = b->skip[0];
+      }
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator old = *this;
+      ++*this;
+      return old;
+    }
+    Iterator &operator--() {
+      while (true) {
+        if (i == 0) {
+          b = b->prev;
+          i = b->used;
+        }
+        --i;
+        if (b->skip[i] == 0)
+          return *this;
+        i -= b->skip[i] - 1; // to the front of the run, then before it
+      }
+    }
+    Iterator operator--(int) {
+      Iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    bool operator==(const Iterator &o) const { return b == o.b && i == o.i; }
+
+  private:
+    friend class Hive;
+    friend class Iterator<!Const>;
+    Iterator(Block *b, size_t i) : b{b}, i{i} {}
+    Block *b = nullptr;
+    size_t i = 0;
+  };
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  Hive() = default;
+  Hive(initializer_list<T> values) : Hive(values.begin(), values.end()) {}
+  template <typename It> Hive(It first, It last) {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+  Hive(const Hive &other) : Hive(other.begin(), other.end()) {}
+  Hive(Hive &&other) noexcept { swap(other); }
+  Hive &operator=(Hive other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~Hive() { clear(); }
+
+  void swap(Hive &other) noexcept {
+    std::swap(first, other.first);
+    std::swap(last, other.last);
+    std::swap(open, other.open);
+    std::swap(n, other.n);
+  }
+
+  size_t size() const { return n; }
+  bool empty() const { return n == 0; }
+
+  iterator begin() { return first ? iterator{first, first->skip[0]} : end(); }
+  iterator end() { return last ? iterator{last, last->used} : iterator{}; }
+  const_iterator begin() const { return const_cast<Hive *>(this)->begin(); }
+  const_iterator end() const { return const_cast<Hive *>(this)->end(); }
+
+  // adds v in the first empty slot there is, or at the back. where it
+  // lands in a walk is up to the hive. no other iterator is invalidated,
+  // except that end() can move.
+  iterator insert(T v) {
+    if (Block *b = open) {
+      uint16_t s = b->runs;
+      uint16_t len = b->skip[s];
+      uint16_t succ = b->slots[s].run.succ;
+      new (&b->slots[s].value) T{move(v)};
+      b->skip[s] = 0;
+      if (len > 1) {
+        // the rest of the run takes this slot's place in the list
+        uint16_t rest = static_cast<uint16_t>(s + 1);
+        b->skip[rest] = b->skip[s + len - 1] = static_cast<uint16_t>(len - 1);
+        b->slots[rest].run = {none, succ};
+        if (succ != none)
+          b->slots[succ].run.prev = rest;
+        b->runs = rest;
+      } else {
+        b->runs = succ;
+        if (succ != none)
+          b->slots[succ].run.prev = none;
+        else
+          close(b);
+      }
+      ++b->count;
+      ++n;
+      return {b, s};
+    }
+    if (!last || last->used == last->cap)
+      add_block();
+    new (&last->slots[last->used].value) T{move(v)};
+    ++last->count;
+    ++n;
+    return {last, last->used++};
+  }
+
+  // the list-style insert: pos is ignored, so code written for list works
+  // unchanged, but v still goes wherever the hive puts it
+  iterator insert(const_iterator, T v) { return insert(move(v)); }
+
+  // takes the value at pos out; returns the position of the one after it
+  iterator erase(const_iterator pos) {
+    Block *b = pos.b;
+    size_t i = pos.i;
+    iterator next = ++iterator{b, i};
+    b->slots[i].value.~T();
+    --b->count;
+    --n;
+    if (b->count == 0) {
+      drop_block(b);
+      return next.b == b ? end() : next;
+    }
+
+    // join the new empty slot with the runs on either side of it
+    uint16_t *skip = b->skip.get();
+    size_t left = i > 0 ? skip[i - 1] : 0;
+    size_t right = skip[i + 1];
+    if (b->runs == none)
+      open_up(b);
+    if (right)
+      unlink_run(b, static_cast<uint16_t>(i + 1));
+    size_t start = i - left;
+    if (!left) {
+      b->slots[i].run = {none, b->runs};
+      if (b->runs != none)
+        b->slots[b->runs].run.prev = static_cast<uint16_t>(i);
+      b->runs = static_cast<uint16_t>(i);
+    }
+    size_t len = left + 1 + right;
+    skip[start] = skip[start + len - 1] = static_cast<uint16_t>(len);
+    return next;
+  }
+
+  void clear() {
+    for (T &v : *this)
+      v.~T();
+    while (first) {
+      Block *b = first;
+      first = first->succ;
+      delete b;
+    }
+    last = open = nullptr;
+    n = 0;
+  }
+
+private:
+  void add_block() {
+    size_t cap = last ? min(2 * last->cap, max_block) : first_block;
+    Block *b = new Block{cap};
+    b->prev = last;
+    (last ? last->succ : first) = b;
+    last = b;
+  }
+
+  // b has no values left: its slots go back to the system
+  void drop_block(Block *b) {
+    if (b->runs != none)
+      close(b);
+    (b->prev ? b->prev->succ : first) = b->succ;
+    (b->succ ? b->succ->prev : last) = b->prev;
+    delete b;
+  }
+
+  // puts b on / takes b off the list of blocks with empty slots to reuse
+  void open_up(Block *b) {
+    b->prev_open = nullptr;
+    b->succ_open = open;
+    if (open)
+      open->prev_open = b;
+    open = b;
+  }
+  void close(Block *b) {
+    (b->prev_open ? b->prev_open->succ_open : open) = b->succ_open;
+    if (b->succ_open)
+      b->succ_open->prev_open = b->prev_open;
+  }
+
+  static void unlink_run(Block *b, uint16_t s) {
+    auto [prev, succ] = b->slots[s].run;
+    (prev != none ? b->slots[prev].run.succ : b->runs) = succ;
+    if (succ != none)
+      b->slots[succ].run.prev = prev;
+  }
+
+  Block *first = nullptr;
+  Block *last = nullptr;
+  Block *open = nullptr; // the first block with empty slots to reuse
+  size_t n = 0;
+};
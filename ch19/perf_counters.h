@@ -0,0 +1,100 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * PerfCounters: reads the cpu's own counters (cycles, instructions, cache
+ * misses, branch misses) around a piece of code through linux's
+ * perf_event_open. a counter the system won't give us (not linux, no
+ * permission, a virtual machine without them) just reads as missing.
+ */
+
+#include "../connor.h"
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+class PerfCounters {
+public:
+  enum Event { cycles, instructions, cache_misses, branch_misses, events };
+  static constexpr array<const char *, events> names = {
+      "cycles", "instructions", "cache_misses", "branch_misses"};
+
+  using Reading = array<optional<uint64_t>, events>;
+
+  PerfCounters() {
+#ifdef __linux__
+    const uint64_t configs[events] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (int e = 0; e < events; ++e) {
+      perf_event_attr attr{};
+      attr.size = sizeof attr;
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = configs[e];
+      attr.disabled = 1;
+      attr.exclude_kernel = 1; // only count this program's own work
+      attr.exclude_hv = 1;
+      fds[e] = static_cast<int>(
+          syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      if (fds[e] < 0)
+        errors[e] = errno;
+    }
+#endif
+  }
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+  ~PerfCounters() {
+#ifdef __linux__
+    for (int fd : fds)
+      if (fd >= 0)
+        close(fd);
+#endif
+  }
+
+  bool available(Event e) const { return fds[e] >= 0; }
+  // why a counter isn't available
+  string why_not(Event e) const { return strerror(errors[e]); }
+
+  void start() {
+#ifdef __linux__
+    for (int fd : fds) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif
+  }
+
+  // the counts since start()
+  Reading stop() {
+    Reading r;
+#ifdef __linux__
+    for (int e = 0; e < events; ++e) {
+      if (fds[e] < 0)
+        continue;
+      ioctl(fds[e], PERF_EVENT_IOC_DISABLE, 0);
+      uint64_t count;
+      if (read(fds[e], &count, sizeof count) == sizeof count)
+        r[e] = count;
+    }
+#endif
+    return r;
+  }
+
+private:
+  array<int, events> fds = {-1, -1, -1, -1};
+  array<int, events> errors = {ENOSYS, ENOSYS, ENOSYS, ENOSYS};
+};
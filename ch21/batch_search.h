@@ -0,0 +1,63 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * checking many titles against a sorted library at once: sort the queries,
+ * then walk both lists together instead of one binary_search per query
+ */
+
+#include "../connor.h"
+#include "string_sort.h"
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+// first position in [pos, last) that is not less than val, looking 1, 2, 4,
+// ... steps ahead before binary searching the last step
+template <random_access_iterator Iterator, typename T>
+Iterator gallop_lower_bound(Iterator pos, Iterator last, const T &val) {
+  auto step = iter_difference_t<Iterator>{1};
+  Iterator lo = pos;
+  while (last - lo > step && lo[step] < val) {
+    lo += step;
+    step *= 2;
+  }
+  Iterator hi = last - lo > step ? lo + step + 1 : last;
+  return lower_bound(lo, hi, val);
+}
+
+// found[i] says whether queries[i] is in the sorted range [first, last).
+// when the library is much bigger than the batch the walk gallops between
+// queries; otherwise it steps through the library one title at a time.
+template <random_access_iterator Iterator, typename Query>
+vector<bool> contains_batch(Iterator first, Iterator last,
+                            const vector<Query> &queries) {
+  vector<size_t> order(queries.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  // titles sort much faster with string_sort than with sort
+  if constexpr (is_convertible_v<const Query &, string_view>)
+    string_sort(order.begin(), order.end(),
+                [&](size_t i) { return string_view{queries[i]}; });
+  else
+    sort(order.begin(), order.end(),
+         [&](size_t a, size_t b) { return queries[a] < queries[b]; });
+
+  const bool gallop = static_cast<size_t>(last - first) > 8 * queries.size();
+  vector<bool> found(queries.size());
+  Iterator pos = first;
+  for (size_t i : order) {
+    const Query &q = queries[i];
+    if (gallop) {
+      pos = gallop_lower_bound(pos, last, q);
+    } else {
+      while (pos != last && *pos < q)
+        ++pos;
+    }
+    found[i] = pos != last && !(q < *pos);
+  }
+  return found;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * blocked bloom filter: answers "definitely not in the library" by looking
+ * at one 64-byte block, so a miss does not have to binary search at all
+ */
+
+#include "../connor.h"
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+
+class BloomFilter {
+public:
+  // one block, so keys can be inserted before it is ever sized
+  BloomFilter() : blocks(1) {}
+
+  // sized for about n keys with the given false positive rate
+  explicit BloomFilter(size_t n, double fp_rate = 0.01) {
+    if (fp_rate <= 0 || fp_rate >= 1)
+      throw invalid_argument("false positive rate must be between 0 and 1");
+    // the textbook size, plus a little because keeping each key's bits in
+    // one block makes some blocks fuller than others
+    const double ln2 = log(2.0);
+    double bits_per_key = -log(fp_rate) / (ln2 * ln2) * 1.1;
+    k = static_cast<unsigned>(clamp(lround(bits_per_key * ln2), 1L, 16L));
+    size_t bits = static_cast<size_t>(ceil(max<size_t>(n, 1) * bits_per_key));
+    blocks.resize((bits + block_bits - 1) / block_bits);
+  }
+
+  template <typename Iterator>
+  BloomFilter(Iterator first, Iterator last, double fp_rate = 0.01)
+      : BloomFilter(static_cast<size_t>(distance(first, last)), fp_rate) {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+
+  void insert(string_view key) {
+    uint64_t h = hash<string_view>{}(key);
+    Block &b = blocks[block_index(h)];
+    for_each_bit(h, [&](unsigned bit) { b.words[bit / 64] |= mask(bit); });
+  }
+
+  // false means the key was never inserted; true means it probably was
+  bool may_contain(string_view key) const {
+    if (blocks.empty())
+      return false;
+    uint64_t h = hash<string_view>{}(key);
+    const Block &b = blocks[block_index(h)];
+    bool all = true;
+    for_each_bit(h, [&](unsigned bit) {
+      all &= (b.words[bit / 64] & mask(bit)) != 0;
+    });
+    return all;
+  }
+
+private:
+  static constexpr unsigned block_bits = 512;
+
+  // one cache line
+  struct alignas(64) Block {
+    uint64_t words[block_bits / 64] = {};
+  };
+
+  static uint64_t mask(unsigned bit) { return uint64_t{1} << (bit % 64); }
+
+  // high bits of the hash pick the block (no modulo)
+  size_t block_index(uint64_t h) const {
+    return static_cast<size_t>(
+        (static_cast<unsigned __int128>(h) * blocks.size()) >> 64);
+  }
+
+  // k bit positions inside the block, 9 bits of a remixed hash each (seven
+  // to a 64-bit word, remixed again when those run out)
+  template <typename F> void for_each_bit(uint64_t h, F &&visit) const {
+    uint64_t g = 0;
+    for (unsigned i = 0; i < k; ++i) {
+      if (i % 7 == 0) {
+        h += 0x9e3779b97f4a7c15ULL;
+        g = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        g = (g ^ (g >> 27)) * 0x94d049bb133111ebULL;
+        g ^= g >> 31;
+      }
+      visit(static_cast<unsigned>(g % block_bits));
+      g /= block_bits;
+    }
+  }
+
+  vector<Block> blocks;
+  unsigned k = 1;
+};
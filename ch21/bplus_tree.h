@@ -0,0 +1,516 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * sorted set of titles that stays sorted as books are added and removed: a
+ * b+ tree with wide nodes, so a search touches a handful of nodes instead of
+ * log2(n) scattered ones, and a walk over the leaves is in sorted order
+ */
+
+#include "../connor.h"
+#include "key_prefix.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+template <typename Key, typename Compare = less<>> class BPlusTree {
+  // about 1 KB of keys per node: 32 strings, 256 ints
+  static constexpr size_t node_bytes = 1024;
+  static constexpr size_t leaf_cap = max<size_t>(8, node_bytes / sizeof(Key));
+  static constexpr size_t inner_cap =
+      max<size_t>(8, node_bytes / (sizeof(Key) + sizeof(void *)));
+  static constexpr size_t leaf_min = leaf_cap / 2;
+  static constexpr size_t inner_min = (inner_cap - 1) / 2;
+
+  // string keys also keep their first 8 bytes in a packed array, so a search
+  // inside a node reads the node instead of chasing every string's pointer
+  static constexpr bool prefixed =
+      is_convertible_v<const Key &, string_view> &&
+      (is_same_v<Compare, less<>> || is_same_v<Compare, less<Key>>);
+  struct NoPrefixes {};
+  template <size_t Cap>
+  using Prefixes = conditional_t<prefixed, array<uint64_t, Cap>, NoPrefixes>;
+
+  struct alignas(64) Node {
+    explicit Node(bool leaf) : leaf{leaf} {}
+    bool leaf;
+    size_t count = 0; // keys in use
+  };
+
+  struct Leaf : Node {
+    Leaf() : Node{true} {}
+    [[no_unique_address]] Prefixes<leaf_cap> prefixes;
+    Key keys[leaf_cap];
+    Leaf *prev = nullptr, *next = nullptr;
+  };
+
+  // children[i] holds the keys below keys[i]; children[i + 1] the ones from
+  // keys[i] up
+  struct Inner : Node {
+    Inner() : Node{false} {}
+    [[no_unique_address]] Prefixes<inner_cap> prefixes;
+    Key keys[inner_cap];
+    Node *children[inner_cap + 1];
+  };
+
+public:
+  class const_iterator {
+  public:
+    using iterator_category = bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = ptrdiff_t;
+    using pointer = const Key *;
+    using reference = const Key &;
+
+    const_iterator() = default;
+
+    reference operator*() const { return leaf->keys[i]; }
+    pointer operator->() const { return &leaf->keys[i]; }
+
+    const_iterator &operator++() {
+      if (++i == leaf->count) {
+        leaf = leaf->next;
+        i = 0;
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator old = *this;
+      ++*this;
+      return old;
+    }
+    const_iterator &operator--() {
+      if (!leaf) {
+        leaf = tree->tail;
+        i = leaf->count - 1;
+      } else if (i == 0) {
+        leaf = leaf->prev;
+        i = leaf->count - 1;
+      } else {
+        --i;
+      }
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    bool operator==(const const_iterator &o) const {
+      return leaf == o.leaf && i == o.i;
+    }
+
+  private:
+    friend class BPlusTree;
+    const_iterator(const Leaf *leaf, size_t i, const BPlusTree *tree)
+        : leaf{leaf}, i{i}, tree{tree} {}
+
+    const Leaf *leaf = nullptr;
+    size_t i = 0;
+    const BPlusTree *tree = nullptr;
+  };
+  using iterator = const_iterator; // keys can't change in place, like set
+
+  BPlusTree() = default;
+
+  // [first, last) must be sorted; repeated keys are kept once
+  template <typename Iterator> BPlusTree(Iterator first, Iterator last) {
+    bulk_load(first, last);
+  }
+
+  BPlusTree(const BPlusTree &other) { bulk_load(other.begin(), other.end()); }
+  BPlusTree(BPlusTree &&other) noexcept { swap(other); }
+  BPlusTree &operator=(BPlusTree other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~BPlusTree() { clear(); }
+
+  void swap(BPlusTree &other) noexcept {
+    std::swap(root, other.root);
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    std::swap(n, other.n);
+    std::swap(comp, other.comp);
+  }
+
+  size_t size() const { return n; }
+  bool empty() const { return n == 0; }
+
+  const_iterator begin() const { return {head, 0, this}; }
+  const_iterator end() const { return {nullptr, 0, this}; }
+
+  void clear() {
+    destroy(root);
+    root = nullptr;
+    head = tail = nullptr;
+    n = 0;
+  }
+
+  // replaces the contents with the sorted range [first, last). leaves are
+  // filled evenly, then each level above is built from the one below.
+  template <typename Iterator> void bulk_load(Iterator first, Iterator last) {
+    vector<Key> keys;
+    for (; first != last; ++first)
+      if (keys.empty() || comp(keys.back(), *first))
+        keys.push_back(*first);
+    clear();
+    if (keys.empty())
+      return;
+
+    // (node, smallest key below it)
+    vector<pair<Node *, const Key *>> level;
+    size_t leaves = (keys.size() + leaf_cap - 1) / leaf_cap;
+    size_t k = 0;
+    for (size_t j = 0; j < leaves; ++j) {
+      Leaf *leaf = new Leaf;
+      size_t take = keys.size() / leaves + (j < keys.size() % leaves);
+      for (size_t t = 0; t < take; ++t)
+        put(leaf, t, move(keys[k++]));
+      leaf->count = take;
+      leaf->prev = tail;
+      (tail ? tail->next : head) = leaf;
+      tail = leaf;
+      level.push_back({leaf, &leaf->keys[0]});
+    }
+    n = keys.size();
+
+    while (level.size() > 1) {
+      vector<pair<Node *, const Key *>> up;
+      size_t groups = (level.size() + inner_cap) / (inner_cap + 1);
+      size_t c = 0;
+      for (size_t j = 0; j < groups; ++j) {
+        Inner *inner = new Inner;
+        size_t take = level.size() / groups + (j < level.size() % groups);
+        for (size_t t = 0; t < take; ++t, ++c) {
+          inner->children[t] = level[c].first;
+          if (t > 0)
+            put(inner, t - 1, Key{*level[c].second});
+        }
+        inner->count = take - 1;
+        up.push_back({inner, level[c - take].second});
+      }
+      level = move(up);
+    }
+    root = level[0].first;
+  }
+
+  // true if key was added, false if it was already there
+  bool insert(const Key &key) {
+    if (!root)
+      root = head = tail = new Leaf;
+    bool added = false;
+    if (auto split = insert_into(root, key, added)) {
+      Inner *top = new Inner;
+      put(top, 0, move(split->first));
+      top->children[0] = root;
+      top->children[1] = split->second;
+      top->count = 1;
+      root = top;
+    }
+    n += added;
+    return added;
+  }
+
+  // number of keys removed (0 or 1)
+  template <typename K> size_t erase(const K &key) {
+    if (!root || !erase_from(root, key))
+      return 0;
+    --n;
+    if (!root->leaf && root->count == 0) {
+      Node *old = root;
+      root = static_cast<Inner *>(old)->children[0];
+      delete static_cast<Inner *>(old);
+    } else if (root->leaf && root->count == 0) {
+      delete static_cast<Leaf *>(root);
+      root = head = tail = nullptr;
+    }
+    return 1;
+  }
+
+  // first key not less than key
+  template <typename K> const_iterator lower_bound(const K &key) const {
+    if (!root)
+      return end();
+    const Node *node = root;
+    while (!node->leaf) {
+      const Inner *in = static_cast<const Inner *>(node);
+      node = in->children[search<true>(in, key)];
+    }
+    const Leaf *leaf = static_cast<const Leaf *>(node);
+    size_t i = search<false>(leaf, key);
+    if (i == leaf->count)
+      return {leaf->next, 0, this};
+    return {leaf, i, this};
+  }
+
+  template <typename K> const_iterator find(const K &key) const {
+    const_iterator it = lower_bound(key);
+    return it != end() && !comp(key, *it) ? it : end();
+  }
+
+  template <typename K> bool contains(const K &key) const {
+    return find(key) != end();
+  }
+
+private:
+  // slot of the first key greater than key (Upper) or not less than it.
+  // with prefixes, only the keys whose prefix ties with key's are compared.
+  template <bool Upper, typename N, typename K>
+  size_t search(const N *node, const K &key) const {
+    const Key *lo = node->keys, *hi = node->keys + node->count;
+    if constexpr (prefixed && is_convertible_v<const K &, string_view>) {
+      const uint64_t p = key_prefix(key);
+      const uint64_t *pre = node->prefixes.data();
+      const uint64_t *a = std::lower_bound(pre, pre + node->count, p);
+      const uint64_t *b = a;
+      while (b != pre + node->count && *b == p)
+        ++b;
+      lo = node->keys + (a - pre);
+      hi = node->keys + (b - pre);
+    }
+    const Key *at = Upper ? std::upper_bound(lo, hi, key, comp)
+                          : std::lower_bound(lo, hi, key, comp);
+    return static_cast<size_t>(at - node->keys);
+  }
+
+  // every key write goes through put or shift so the prefixes follow along
+  template <typename N> static void put(N *node, size_t i, Key &&key) {
+    node->keys[i] = move(key);
+    if constexpr (prefixed)
+      node->prefixes[i] = key_prefix(node->keys[i]);
+  }
+
+  // moves keys [from, from + len) of src to dst starting at to; src and dst
+  // may be the same node
+  template <typename N>
+  static void shift(N *src, size_t from, size_t len, N *dst, size_t to) {
+    if (src == dst && to > from)
+      move_backward(src->keys + from, src->keys + from + len,
+                    dst->keys + to + len);
+    else
+      move(src->keys + from, src->keys + from + len, dst->keys + to);
+    if constexpr (prefixed)
+      memmove(dst->prefixes.data() + to, src->prefixes.data() + from,
+              len * sizeof(uint64_t));
+  }
+
+  // a node that split hands back the first key of its new right half and
+  // the new node itself
+  using Split = optional<pair<Key, Node *>>;
+
+  Split insert_into(Node *node, const Key &key, bool &added) {
+    if (node->leaf)
+      return insert_into_leaf(static_cast<Leaf *>(node), key, added);
+
+    Inner *in = static_cast<Inner *>(node);
+    size_t idx = search<true>(in, key);
+    Split below = insert_into(in->children[idx], key, added);
+    if (!below)
+      return nullopt;
+
+    if (in->count < inner_cap) {
+      shift(in, idx, in->count - idx, in, idx + 1);
+      move_backward(in->children + idx + 1, in->children + in->count + 1,
+                    in->children + in->count + 2);
+      put(in, idx, move(below->first));
+      in->children[idx + 1] = below->second;
+      ++in->count;
+      return nullopt;
+    }
+
+    // full: lay out all cap + 1 keys, keep the lower half, send the middle
+    // key up and the upper half to a new node
+    vector<Key> keys(make_move_iterator(in->keys),
+                     make_move_iterator(in->keys + in->count));
+    vector<Node *> children(in->children, in->children + in->count + 1);
+    keys.insert(keys.begin() + idx, move(below->first));
+    children.insert(children.begin() + idx + 1, below->second);
+
+    size_t left = keys.size() / 2;
+    Inner *right = new Inner;
+    in->count = left;
+    right->count = keys.size() - left - 1;
+    for (size_t i = 0; i < left; ++i) {
+      put(in, i, move(keys[i]));
+      in->children[i] = children[i];
+    }
+    in->children[left] = children[left];
+    for (size_t i = 0; i < right->count; ++i) {
+      put(right, i, move(keys[left + 1 + i]));
+      right->children[i] = children[left + 1 + i];
+    }
+    right->children[right->count] = children.back();
+    return pair<Key, Node *>{move(keys[left]), right};
+  }
+
+  Split insert_into_leaf(Leaf *leaf, const Key &key, bool &added) {
+    size_t pos = search<false>(leaf, key);
+    if (pos < leaf->count && !comp(key, leaf->keys[pos]))
+      return nullopt; // already there
+    added = true;
+
+    if (leaf->count < leaf_cap) {
+      shift(leaf, pos, leaf->count - pos, leaf, pos + 1);
+      put(leaf, pos, Key{key});
+      ++leaf->count;
+      return nullopt;
+    }
+
+    // full: the upper half moves to a new leaf, then the key goes into
+    // whichever half it belongs to
+    Leaf *right = new Leaf;
+    size_t left = (leaf_cap + 1) / 2;
+    if (pos < left)
+      --left; // the new key will make the left half one bigger
+    shift(leaf, left, leaf_cap - left, right, 0);
+    right->count = leaf_cap - left;
+    leaf->count = left;
+
+    Leaf *target = pos <= left ? leaf : right;
+    size_t at = pos <= left ? pos : pos - left;
+    shift(target, at, target->count - at, target, at + 1);
+    put(target, at, Key{key});
+    ++target->count;
+
+    right->next = leaf->next;
+    right->prev = leaf;
+    (leaf->next ? leaf->next->prev : tail) = right;
+    leaf->next = right;
+    return pair<Key, Node *>{right->keys[0], right};
+  }
+
+  template <typename K> bool erase_from(Node *node, const K &key) {
+    if (node->leaf) {
+      Leaf *leaf = static_cast<Leaf *>(node);
+      size_t pos = search<false>(leaf, key);
+      if (pos == leaf->count || comp(key, leaf->keys[pos]))
+        return false;
+      shift(leaf, pos + 1, leaf->count - pos - 1, leaf, pos);
+      --leaf->count;
+      return true;
+    }
+    Inner *in = static_cast<Inner *>(node);
+    size_t idx = search<true>(in, key);
+    if (!erase_from(in->children[idx], key))
+      return false;
+    rebalance(in, idx);
+    return true;
+  }
+
+  // children[idx] of parent may have dropped below the minimum: borrow a key
+  // from a sibling that can spare one, or merge with a sibling
+  void rebalance(Inner *parent, size_t idx) {
+    Node *child = parent->children[idx];
+    Node *left = idx > 0 ? parent->children[idx - 1] : nullptr;
+    Node *right = idx < parent->count ? parent->children[idx + 1] : nullptr;
+
+    if (child->leaf) {
+      if (child->count >= leaf_min)
+        return;
+      Leaf *c = static_cast<Leaf *>(child);
+      Leaf *l = static_cast<Leaf *>(left), *r = static_cast<Leaf *>(right);
+      if (l && l->count > leaf_min) {
+        shift(c, 0, c->count, c, 1);
+        shift(l, --l->count, 1, c, 0);
+        ++c->count;
+        put(parent, idx - 1, Key{c->keys[0]});
+      } else if (r && r->count > leaf_min) {
+        shift(r, 0, 1, c, c->count++);
+        shift(r, 1, --r->count, r, 0);
+        put(parent, idx, Key{r->keys[0]});
+      } else if (l) {
+        merge_leaves(parent, idx - 1);
+      } else if (r) {
+        merge_leaves(parent, idx);
+      }
+      return;
+    }
+
+    if (child->count >= inner_min)
+      return;
+    Inner *c = static_cast<Inner *>(child);
+    Inner *l = static_cast<Inner *>(left), *r = static_cast<Inner *>(right);
+    if (l && l->count > inner_min) {
+      shift(c, 0, c->count, c, 1);
+      move_backward(c->children, c->children + c->count + 1,
+                    c->children + c->count + 2);
+      shift(parent, idx - 1, 1, c, 0);
+      c->children[0] = l->children[l->count];
+      shift(l, l->count - 1, 1, parent, idx - 1);
+      --l->count;
+      ++c->count;
+    } else if (r && r->count > inner_min) {
+      shift(parent, idx, 1, c, c->count);
+      c->children[c->count + 1] = r->children[0];
+      ++c->count;
+      shift(r, 0, 1, parent, idx);
+      shift(r, 1, r->count - 1, r, 0);
+      move(r->children + 1, r->children + r->count + 1, r->children);
+      --r->count;
+    } else if (l) {
+      merge_inners(parent, idx - 1);
+    } else if (r) {
+      merge_inners(parent, idx);
+    }
+  }
+
+  // drops keys[i] and children[i + 1] from an inner node
+  static void remove_slot(Inner *in, size_t i) {
+    shift(in, i + 1, in->count - i - 1, in, i);
+    move(in->children + i + 2, in->children + in->count + 1,
+         in->children + i + 1);
+    --in->count;
+  }
+
+  // children[i + 1] is folded into children[i]
+  void merge_leaves(Inner *parent, size_t i) {
+    Leaf *l = static_cast<Leaf *>(parent->children[i]);
+    Leaf *r = static_cast<Leaf *>(parent->children[i + 1]);
+    shift(r, 0, r->count, l, l->count);
+    l->count += r->count;
+    l->next = r->next;
+    (r->next ? r->next->prev : tail) = l;
+    delete r;
+    remove_slot(parent, i);
+  }
+
+  void merge_inners(Inner *parent, size_t i) {
+    Inner *l = static_cast<Inner *>(parent->children[i]);
+    Inner *r = static_cast<Inner *>(parent->children[i + 1]);
+    shift(parent, i, 1, l, l->count);
+    shift(r, 0, r->count, l, l->count + 1);
+    copy(r->children, r->children + r->count + 1,
+         l->children + l->count + 1);
+    l->count += r->count + 1;
+    delete r;
+    remove_slot(parent, i);
+  }
+
+  void destroy(Node *node) {
+    if (!node)
+      return;
+    if (node->leaf) {
+      delete static_cast<Leaf *>(node);
+      return;
+    }
+    Inner *in = static_cast<Inner *>(node);
+    for (size_t i = 0; i <= in->count; ++i)
+      destroy(in->children[i]);
+    delete in;
+  }
+
+  Node *root = nullptr;
+  Leaf *head = nullptr, *tail = nullptr; // leaves in order, for iterators
+  size_t n = 0;
+  [[no_unique_address]] Compare comp;
+};
@@ -0,0 +1,543 @@
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * timings for the library search code on a large made up catalog
+ * usage: ch21_bench [section] [number of titles]
+ */
+
+#include "../connor.h"
+#include "batch_search.h"
+#include "bloom_filter.h"
+#include "bplus_tree.h"
+#include "collation.h"
+#include "eytzinger.h"
+#include "find.h"
+#include "inverted_index.h"
+#include "ranking.h"
+#include "string_pool.h"
+#include "string_sort.h"
+#include <chrono>
+#include <random>
+#include <set>
+
+// made up vocabulary: tens of thousands of pronounceable words
+const vector<string> &vocabulary() {
+  static const vector<string> words = [] {
+    const vector<string> syllables = {
+        "ka", "lo", "mir", "an", "the", "dra", "gon", "el", "ven", "sha",
+        "dow", "ri", "ver", "ash", "win", "ter", "crow", "gar", "den", "mo",
+        "on", "sil", "ent", "fo", "rest", "iron", "bel", "tor", "ca", "lin"};
+    mt19937_64 rng(42);
+    vector<string> w;
+    for (int i = 0; i < 50000; ++i) {
+      string word;
+      for (size_t s = 2 + rng() % 3; s > 0; --s)
+        word += syllables[rng() % syllables.size()];
+      word[0] = static_cast<char>(toupper(word[0]));
+      w.push_back(word);
+    }
+    return w;
+  }();
+  return words;
+}
+
+// made up titles like "The Dragonven of Sil Ashka", with the shared
+// prefixes ("The ...") real catalogs have
+vector<string> make_titles(size_t n, unsigned seed = 1) {
+  const vector<string> &words = vocabulary();
+  static const vector<string> joins = {" of ", " and ", " in the ", " "};
+  mt19937_64 rng(seed);
+  vector<string> titles;
+  titles.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    string t = rng() % 3 == 0 ? "The " : "";
+    t += words[rng() % words.size()];
+    for (size_t extra = 1 + rng() % 3; extra > 0; --extra) {
+      t += joins[rng() % joins.size()];
+      t += words[rng() % words.size()];
+    }
+    titles.push_back(move(t));
+  }
+  return titles;
+}
+
+// half the queries are in the catalog, half are not
+vector<string> make_queries(const vector<string> &titles, size_t q) {
+  mt19937_64 rng(7);
+  vector<string> queries = make_titles(q / 2, 99);
+  for (size_t i = queries.size(); i < q; ++i)
+    queries.push_back(titles[rng() % titles.size()]);
+  shuffle(queries.begin(), queries.end(), rng);
+  return queries;
+}
+
+template <typename F> double time_ms(F &&f) {
+  auto start = chrono::steady_clock::now();
+  f();
+  chrono::duration<double, milli> d = chrono::steady_clock::now() - start;
+  return d.count();
+}
+
+void bench_eytzinger(size_t n) {
+  cout << "=== eytzinger index vs binary_search, " << n << " titles ===\n";
+  vector<string> library = make_titles(n);
+  sort(library.begin(), library.end());
+  library.erase(unique(library.begin(), library.end()), library.end());
+  vector<string> queries = make_queries(library, 1000000);
+
+  EytzingerIndex index;
+  double build = time_ms([&] { index = {library.begin(), library.end()}; });
+
+  size_t hits_bs = 0, hits_ey = 0;
+  double bs = time_ms([&] {
+    for (const string &q : queries)
+      hits_bs += binary_search(library.begin(), library.end(), q);
+  });
+  double ey = time_ms([&] {
+    for (const string &q : queries)
+      hits_ey += index.contains(q);
+  });
+
+  cout << "  build:         " << build << " ms\n";
+  cout << "  binary_search: " << bs << " ms (" << hits_bs << " hits)\n";
+  cout << "  eytzinger:     " << ey << " ms (" << hits_ey << " hits)\n";
+  cout << "  speedup:       " << bs / ey << "x\n";
+  if (hits_bs != hits_ey)
+    cout << "  MISMATCH in hit counts!\n";
+}
+
+void bench_sort(size_t n) {
+  cout << "=== string_sort vs sort, " << n << " titles ===\n";
+  vector<string> titles = make_titles(n);
+  vector<string> a = titles, b = titles, c = titles;
+
+  double std_ms = time_ms([&] { sort(a.begin(), a.end()); });
+  double one_ms =
+      time_ms([&] { string_sort(b.begin(), b.end(), identity{}, 1); });
+  double all_ms = time_ms([&] { string_sort(c.begin(), c.end()); });
+
+  cout << "  sort:                  " << std_ms << " ms\n";
+  cout << "  string_sort, 1 thread: " << one_ms << " ms\n";
+  cout << "  string_sort, parallel:  " << all_ms << " ms ("
+       << thread::hardware_concurrency() << " hardware threads)\n";
+  if (a != b || a != c)
+    cout << "  MISMATCH with sort!\n";
+}
+
+void bench_words(size_t n) {
+  cout << "=== inverted index word search, " << n << " titles ===\n";
+  vector<string> titles = make_titles(n);
+  InvertedIndex index;
+  double build = time_ms([&] { index = {titles.begin(), titles.end()}; });
+
+  // two-word AND queries and one-word lookups from the same vocabulary
+  const vector<string> &words = vocabulary();
+  mt19937_64 rng(3);
+  const size_t q = 10000;
+  vector<string> pairs, singles;
+  for (size_t i = 0; i < q; ++i) {
+    pairs.push_back(words[rng() % words.size()] + " " +
+                    words[rng() % words.size()]);
+    singles.push_back(words[rng() % words.size()]);
+  }
+
+  size_t and_hits = 0, or_hits = 0;
+  double and_ms = time_ms([&] {
+    for (const string &s : pairs)
+      and_hits += index.search_all(s).size();
+  });
+  double or_ms = time_ms([&] {
+    for (const string &s : singles)
+      or_hits += index.search_any(s).size();
+  });
+
+  cout << "  build:       " << build << " ms\n";
+  cout << "  AND, 2 words: " << and_ms * 1000 / q << " us/query ("
+       << and_hits << " hits)\n";
+  cout << "  one word:     " << or_ms * 1000 / q << " us/query (" << or_hits
+       << " hits)\n";
+}
+
+// a word from the vocabulary, low numbers much more often (roughly the way
+// "the" is more common than "gatsby")
+const string &skewed_word(mt19937_64 &rng) {
+  const vector<string> &words = vocabulary();
+  size_t v = words.size();
+  return words[(rng() % v) * (rng() % v) / v];
+}
+
+void bench_ranked(size_t n) {
+  cout << "=== bm25 top-10, " << n << " titles with descriptions ===\n";
+  vector<string> titles = make_titles(n);
+  Bm25Index index;
+  mt19937_64 rng(11);
+  double build = time_ms([&] {
+    for (const string &title : titles) {
+      string text = title;
+      for (size_t w = 5 + rng() % 55; w > 0; --w) {
+        text += ' ';
+        text += skewed_word(rng);
+      }
+      index.add(text);
+    }
+    index.finish();
+  });
+  titles.clear();
+  titles.shrink_to_fit();
+
+  const size_t q = 200;
+  vector<string> queries;
+  for (size_t i = 0; i < q; ++i) {
+    // one common word plus one or two ordinary ones ("dragon of ...")
+    string query = skewed_word(rng);
+    for (size_t w = 1 + rng() % 2; w > 0; --w)
+      query += " " + vocabulary()[rng() % vocabulary().size()];
+    queries.push_back(query);
+  }
+
+  RankStats pruned, full;
+  vector<vector<SearchHit>> a, b;
+  double pruned_ms = time_ms([&] {
+    for (const string &s : queries)
+      a.push_back(index.top_k(s, 10, &pruned));
+  });
+  double full_ms = time_ms([&] {
+    for (const string &s : queries)
+      b.push_back(index.top_k_exhaustive(s, 10, &full));
+  });
+
+  size_t differ = 0;
+  for (size_t i = 0; i < q; ++i)
+    for (size_t j = 0; j < a[i].size(); ++j)
+      differ += j >= b[i].size() || abs(a[i][j].score - b[i][j].score) > 1e-4;
+
+  cout << "  build:            " << build << " ms\n";
+  cout << "  score everything: " << full_ms * 1000 / q << " us/query, "
+       << full.scored / q << " docs scored/query\n";
+  cout << "  maxscore + block: " << pruned_ms * 1000 / q << " us/query, "
+       << pruned.scored / q << " docs scored/query\n";
+  if (differ)
+    cout << "  " << differ << " results differ from scoring everything!\n";
+}
+
+void bench_batch(size_t n) {
+  cout << "=== batch membership, " << n << " titles ===\n";
+  vector<string> library = make_titles(n);
+  sort(library.begin(), library.end());
+
+  for (size_t q : {n / 1000, n / 10, n}) {
+    vector<string> queries = make_queries(library, q);
+    vector<bool> one(q), batch;
+    double bs = time_ms([&] {
+      for (size_t i = 0; i < q; ++i)
+        one[i] = binary_search(library.begin(), library.end(), queries[i]);
+    });
+    double merged = time_ms([&] {
+      batch = contains_batch(library.begin(), library.end(), queries);
+    });
+    cout << "  " << q << " queries: binary_search " << bs
+         << " ms, contains_batch " << merged << " ms"
+         << (one == batch ? "" : " MISMATCH!") << '\n';
+  }
+}
+
+void bench_bloom(size_t n) {
+  cout << "=== bloom filter in front of binary_search, " << n
+       << " titles ===\n";
+  vector<string> library = make_titles(n);
+  sort(library.begin(), library.end());
+  library.erase(unique(library.begin(), library.end()), library.end());
+
+  // mostly misses: nine made up titles for every real one
+  mt19937_64 rng(5);
+  const size_t q = 1000000;
+  vector<string> queries = make_titles(q * 9 / 10, 77);
+  while (queries.size() < q)
+    queries.push_back(library[rng() % library.size()]);
+  shuffle(queries.begin(), queries.end(), rng);
+
+  size_t plain_hits = 0;
+  double plain = time_ms([&] {
+    for (const string &s : queries)
+      plain_hits += binary_search(library.begin(), library.end(), s);
+  });
+  cout << "  binary_search only: " << plain << " ms\n";
+
+  for (double fp : {0.1, 0.01, 0.001}) {
+    BloomFilter filter(library.begin(), library.end(), fp);
+    size_t passed = 0, hits = 0;
+    double ms = time_ms([&] {
+      for (const string &s : queries) {
+        if (!filter.may_contain(s))
+          continue;
+        ++passed;
+        hits += binary_search(library.begin(), library.end(), s);
+      }
+    });
+    double false_pos =
+        static_cast<double>(passed - hits) / static_cast<double>(q - hits);
+    cout << "  filter at " << fp << ": " << ms << " ms, measured false "
+         << "positive rate " << false_pos
+         << (hits == plain_hits ? "" : " MISMATCH!") << '\n';
+  }
+}
+
+void bench_btree(size_t n) {
+  cout << "=== mixed insert/erase/search, " << n << " titles ===\n";
+  vector<string> library = make_titles(n);
+  sort(library.begin(), library.end());
+  library.erase(unique(library.begin(), library.end()), library.end());
+
+  // a third each of new titles added, existing ones removed, lookups
+  const size_t ops = 300000;
+  vector<string> fresh = make_titles(ops, 88);
+  mt19937_64 rng(9);
+  vector<pair<int, string>> work;
+  for (size_t i = 0; i < ops; ++i) {
+    int op = static_cast<int>(i % 3);
+    work.push_back({op, op == 0 ? fresh[i] : library[rng() % library.size()]});
+  }
+
+  vector<string> vec;
+  BPlusTree<string> tree;
+  set<string> tree_set;
+  double load_vec = time_ms([&] { vec = library; });
+  double load_tree =
+      time_ms([&] { tree.bulk_load(library.begin(), library.end()); });
+  double load_set =
+      time_ms([&] { tree_set = set<string>(library.begin(), library.end()); });
+  cout << "  load: sorted vector " << load_vec << " ms, BPlusTree "
+       << load_tree << " ms, set " << load_set << " ms\n";
+
+  // every vector insert or erase shifts half the library, so it only gets
+  // the first 1% of the work
+  const size_t vec_ops = ops / 100;
+  double v = time_ms([&] {
+    for (size_t i = 0; i < vec_ops; ++i) {
+      const auto &[op, s] = work[i];
+      auto it = lower_bound(vec.begin(), vec.end(), s);
+      bool there = it != vec.end() && *it == s;
+      if (op == 0 && !there)
+        vec.insert(it, s);
+      else if (op == 1 && there)
+        vec.erase(it);
+    }
+  });
+  size_t tree_found = 0, set_found = 0;
+  double t = time_ms([&] {
+    for (const auto &[op, s] : work) {
+      if (op == 0)
+        tree.insert(s);
+      else if (op == 1)
+        tree.erase(s);
+      else
+        tree_found += tree.contains(s);
+    }
+  });
+  double st = time_ms([&] {
+    for (const auto &[op, s] : work) {
+      if (op == 0)
+        tree_set.insert(s);
+      else if (op == 1)
+        tree_set.erase(s);
+      else
+        set_found += tree_set.count(s);
+    }
+  });
+  bool same = set_found == tree_found && equal(tree_set.begin(), tree_set.end(),
+                                               tree.begin(), tree.end());
+  cout << "  microseconds per op: sorted vector " << v * 1000 / vec_ops
+       << ", BPlusTree " << t * 1000 / ops << ", set " << st * 1000 / ops
+       << (same ? "" : " MISMATCH!") << '\n';
+
+  double walk_tree = time_ms([&] {
+    tree_found = static_cast<size_t>(count_if(
+        tree.begin(), tree.end(), [](const string &s) { return s[0] == 'T'; }));
+  });
+  double walk_set = time_ms([&] {
+    set_found = static_cast<size_t>(
+        count_if(tree_set.begin(), tree_set.end(),
+                 [](const string &s) { return s[0] == 'T'; }));
+  });
+  cout << "  in-order walk: BPlusTree " << walk_tree << " ms, set " << walk_set
+       << " ms" << (tree_found == set_found ? "" : " MISMATCH!") << '\n';
+}
+
+void bench_collate(size_t n) {
+  cout << "=== library order (case and article blind), " << n
+       << " titles ===\n";
+  vector<string> titles = make_titles(n);
+  // mixed case, as people type them
+  mt19937_64 rng(4);
+  for (string &t : titles)
+    if (rng() % 4 == 0)
+      for (char &c : t)
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+
+  vector<string> a = titles;
+  double per_compare = time_ms([&] {
+    sort(a.begin(), a.end(), [](const string &x, const string &y) {
+      return collation_key(x) < collation_key(y);
+    });
+  });
+  vector<CollatedTitle> b;
+  double keyed = time_ms([&] {
+    b.reserve(titles.size());
+    for (const string &t : titles)
+      b.push_back({collation_key(t), t});
+    sort(b.begin(), b.end(), KeyLess{});
+  });
+  vector<CollatedTitle> c;
+  double keyed_mkqs =
+      time_ms([&] { c = collate_titles(titles.begin(), titles.end()); });
+
+  bool same = a.size() == b.size();
+  for (size_t i = 0; same && i < a.size(); ++i)
+    same = collation_key(a[i]) == b[i].key && b[i].key == c[i].key;
+  cout << "  sort, normalizing in the comparator: " << per_compare << " ms\n";
+  cout << "  keys once, then sort with memcmp:    " << keyed << " ms\n";
+  cout << "  keys once, then string_sort:         " << keyed_mkqs << " ms"
+       << (same ? "" : " MISMATCH!") << '\n';
+}
+
+void bench_pool(size_t n) {
+  cout << "=== vector<string> vs StringPool, " << n << " titles ===\n";
+  vector<string> titles = make_titles(n);
+  vector<string> vec;
+  StringPool pool;
+  double build_vec = time_ms([&] { vec = titles; });
+  double build_pool =
+      time_ms([&] { pool = StringPool(titles.begin(), titles.end()); });
+  cout << "  build: vector " << build_vec << " ms, pool " << build_pool
+       << " ms\n";
+
+  double sort_vec = time_ms([&] { sort(vec.begin(), vec.end()); });
+  double sort_pool = time_ms([&] { sort(pool.begin(), pool.end()); });
+  cout << "  sort: vector " << sort_vec << " ms, pool " << sort_pool
+       << " ms\n";
+
+  // half hits, half made up titles
+  vector<string> queries = make_titles(500000, 31);
+  mt19937_64 rng(6);
+  for (size_t i = 0; i < 500000; ++i)
+    queries.push_back(titles[rng() % titles.size()]);
+  shuffle(queries.begin(), queries.end(), rng);
+  size_t vec_hits = 0, pool_hits = 0;
+  double bs_vec = time_ms([&] {
+    for (const string &q : queries)
+      vec_hits += binary_search(vec.begin(), vec.end(), q);
+  });
+  double bs_pool = time_ms([&] {
+    for (const string &q : queries)
+      pool_hits += binary_search(pool.begin(), pool.end(), PooledString{q});
+  });
+  cout << "  " << queries.size() << " binary_searches: vector " << bs_vec
+       << " ms, pool " << bs_pool << " ms"
+       << (vec_hits == pool_hits ? "" : " MISMATCH!") << '\n';
+
+  // whole-list scans for titles that aren't there
+  const size_t scans = 20;
+  size_t vec_found = 0, pool_found = 0;
+  double find_vec = time_ms([&] {
+    for (size_t i = 0; i < scans; ++i)
+      vec_found += my_find(vec.begin(), vec.end(), queries[i]) != vec.end();
+  });
+  double find_pool = time_ms([&] {
+    for (size_t i = 0; i < scans; ++i) {
+      PooledString q{queries[i]};
+      pool_found += my_find(pool.begin(), pool.end(), q) != pool.end();
+    }
+  });
+  cout << "  " << scans << " my_find scans: vector " << find_vec
+       << " ms, pool " << find_pool << " ms"
+       << (vec_found == pool_found ? "" : " MISMATCH!") << '\n';
+}
+
+// my_find on a big vector<int>: the generic loop, the avx2 overload and
+// my_find_par, which all have to give the same first match
+void bench_find(size_t n) {
+  const unsigned threads = 4; // even on one cpu, so the pieces get tested
+  cout << "=== my_find over " << n << " ints ("
+#ifdef MY_FIND_X86
+       << (find_detail::has_avx2() ? "avx2" : "no avx2, scalar")
+#else
+       << "not x86, scalar"
+#endif
+       << "), my_find_par with " << threads << " threads ===\n";
+  vector<int> values(n);
+  for (size_t i = 0; i < n; ++i)
+    values[i] = static_cast<int>(i);
+  const int needle = -1;
+
+  // where the needle is planted; the first one is the answer
+  const size_t piece = (n + threads - 1) / threads; // my_find_par's pieces
+  const vector<pair<string, vector<size_t>>> cases = {
+      {"miss", {}},
+      {"first block", {5}},
+      {"last of piece 0, again in piece 1", {piece - 1, piece + 2}},
+      {"first of piece 1, again in piece 3", {piece, 3 * piece + 7}},
+      {"only in the last piece", {n - 3}},
+  };
+
+  for (const auto &[name, at] : cases) {
+    for (size_t i : at)
+      values[i] = needle;
+    size_t want = at.empty() ? n : at[0];
+    size_t generic = 0, fast = 0, par = 0;
+    // move_iterator is never contiguous, so this takes the generic loop
+    double generic_ms = time_ms([&] {
+      generic = static_cast<size_t>(
+          my_find(make_move_iterator(values.cbegin()),
+                  make_move_iterator(values.cend()), needle)
+              .base() -
+          values.cbegin());
+    });
+    double fast_ms = time_ms([&] {
+      fast = static_cast<size_t>(
+          my_find(values.cbegin(), values.cend(), needle) - values.cbegin());
+    });
+    double par_ms = time_ms([&] {
+      par = static_cast<size_t>(
+          my_find_par(values.cbegin(), values.cend(), needle, threads) -
+          values.cbegin());
+    });
+    cout << "  " << name << ": generic " << generic_ms << " ms, my_find "
+         << fast_ms << " ms, my_find_par " << par_ms << " ms"
+         << (generic == want && fast == want && par == want ? ""
+                                                            : " MISMATCH!")
+         << '\n';
+    for (size_t i : at)
+      values[i] = static_cast<int>(i);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  string section = argc > 1 ? argv[1] : "all";
+  size_t n = argc > 2 ? stoul(argv[2]) : 1000000;
+  size_t ranked_n = argc > 2 ? n : 5000000;
+
+  if (section == "all" || section == "eytzinger")
+    bench_eytzinger(n);
+  if (section == "all" || section == "sort")
+    bench_sort(n);
+  if (section == "all" || section == "collate")
+    bench_collate(n);
+  if (section == "all" || section == "pool")
+    bench_pool(n);
+  if (section == "all" || section == "words")
+    bench_words(n);
+  if (section == "all" || section == "batch")
+    bench_batch(n);
+  if (section == "all" || section == "bloom")
+    bench_bloom(n);
+  if (section == "all" || section == "btree")
+    bench_btree(n);
+  if (section == "all" || section == "ranked")
+    bench_ranked(ranked_n);
+  if (section == "all" || section == "find")
+    bench_find(max<size_t>(n * 16, size_t{1} << 20));
+
+  return 0;
+}
@@ -6,30 +6,26 @@
  */
 
 #include "../connor.h"
+#include "find.h"
+#include "inverted_index.h"
+#include "string_pool.h"
 // add 10 contacts
 
-template <typename Iterator, typename T>
-Iterator my_find(Iterator first, Iterator last, const T &val) {
-  while (first != last && *first != val)
-    ++first;
-  return first;
-}
-
 int main() {
-  vector<string> books = {"The Hobbit",
-                          "1984",
-                          "Brave New World",
-                          "Dune",
-                          "To Kill a Mockingbird",
-                          "The Great Gatsby",
-                          "The Lord of the Rings",
-                          "The Catcher in the Rye",
-                          "The Handmaid's Tale",
-                          "The Alchemist"};
+  StringPool books = {"The Hobbit",
+                      "1984",
+                      "Brave New World",
+                      "Dune",
+                      "To Kill a Mockingbird",
+                      "The Great Gatsby",
+                      "The Lord of the Rings",
+                      "The Catcher in the Rye",
+                      "The Handmaid's Tale",
+                      "The Alchemist"};
 
   // show available books
   cout << "Available books in the library:\n";
-  for (const string &book : books) {
+  for (const PooledString &book : books) {
     cout << " - " << book << '\n';
   }
 
@@ -42,10 +38,21 @@ int main() {
   auto it = my_find(books.begin(), books.end(), target);
 
   // show result
-  if (it != books.end())
+  if (it != books.end()) {
     cout << "\n Found: " << *it << '\n';
-  else
+    return 0;
+  }
+
+  // no exact title: look for books that have all the words instead
+  InvertedIndex index(books.begin(), books.end());
+  vector<uint32_t> matches = index.search_all(target);
+  if (matches.empty()) {
     cout << "\n Book not found.\n";
+  } else {
+    cout << "\n Books matching \"" << target << "\":\n";
+    for (uint32_t i : matches)
+      cout << " - " << books[i] << '\n';
+  }
 
   return 0;
 }
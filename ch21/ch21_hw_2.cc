@@ -6,6 +6,8 @@
  */
 
 #include "../connor.h"
+#include "bloom_filter.h"
+#include "collation.h"
 
 // binary search
 
@@ -22,18 +24,27 @@ int main() {
                             "The Handmaid's Tale",
                             "The Alchemist"};
 
-  sort(library.begin(), library.end());
+  // library order: ignoring case, and "The Great Gatsby" under G
+  vector<CollatedTitle> catalog = collate_titles(library.begin(), library.end());
 
   cout << "sorrted library: \n";
-  for (const string &title : library) {
-    cout << " - " << title << '\n';
+  for (const CollatedTitle &book : catalog) {
+    cout << " - " << book.title << '\n';
   }
 
+  // most searches are for books we don't have; the filter turns those away
+  // without searching
+  BloomFilter filter(catalog.size(), 0.01);
+  for (const CollatedTitle &book : catalog)
+    filter.insert(book.key);
+
   string search_title;
   cout << "\nEnter a book title to search for: ";
   getline(cin, search_title);
 
-  bool found = binary_search(library.begin(), library.end(), search_title);
+  string key = collation_key(search_title);
+  bool found = filter.may_contain(key) &&
+               binary_search(catalog.begin(), catalog.end(), key, KeyLess{});
   if (found)
     cout << '"' << search_title << "\" was found in the library.\n";
   else
@@ -0,0 +1,98 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * library order for titles: case doesn't matter and a leading "The", "A" or
+ * "An" is filed after the rest, so "The Great Gatsby" sorts under G. each
+ * title's sort key is built once; after that, comparing two titles is one
+ * memcmp.
+ */
+
+#include "../connor.h"
+#include "string_sort.h"
+#include <cctype>
+#include <cstring>
+#include <string_view>
+
+// the sort key for a title: lower case, runs of spaces (and control
+// characters) made single spaces, no spaces at either end, and a leading
+// article moved to the end behind a \x01, which sorts before every printable
+// character. "the Hobbit" and "The Hobbit" get the same key,
+// "hobbit\x01the"; "Hobbit" gets "hobbit" and sorts just before them.
+// only ascii letters change case.
+inline string collation_key(string_view title) {
+  string key;
+  key.reserve(title.size() + 1);
+  for (char ch : title) {
+    unsigned char c = static_cast<unsigned char>(ch);
+    if (c <= ' ') {
+      if (!key.empty() && key.back() != ' ')
+        key += ' ';
+    } else {
+      key += static_cast<char>(tolower(c));
+    }
+  }
+  if (!key.empty() && key.back() == ' ')
+    key.pop_back();
+
+  for (string_view article : {"the ", "a ", "an "}) {
+    if (key.size() > article.size() && key.starts_with(article)) {
+      key.erase(0, article.size());
+      key += '\x01';
+      key.append(article.substr(0, article.size() - 1));
+      break;
+    }
+  }
+  return key;
+}
+
+// byte order of sort keys; memcmp compares as unsigned char
+inline bool key_less(string_view a, string_view b) {
+  int c = memcmp(a.data(), b.data(), min(a.size(), b.size()));
+  return c < 0 || (c == 0 && a.size() < b.size());
+}
+
+// a title with its sort key
+struct CollatedTitle {
+  string key;
+  string title;
+};
+
+// orders CollatedTitles by key, and compares them with bare keys, so
+// lower_bound and binary_search can look up a key directly
+struct KeyLess {
+  bool operator()(const CollatedTitle &a, const CollatedTitle &b) const {
+    return key_less(a.key, b.key);
+  }
+  bool operator()(const CollatedTitle &a, string_view key) const {
+    return key_less(a.key, key);
+  }
+  bool operator()(string_view key, const CollatedTitle &b) const {
+    return key_less(key, b.key);
+  }
+};
+
+// the titles in [first, last) with their keys, in library order
+template <typename Iterator>
+vector<CollatedTitle> collate_titles(Iterator first, Iterator last) {
+  vector<CollatedTitle> out;
+  for (; first != last; ++first) {
+    string title{*first};
+    string key = collation_key(title);
+    out.push_back({move(key), move(title)});
+  }
+  // string_sort orders by unsigned bytes too, so it agrees with key_less
+  string_sort(out.begin(), out.end(),
+              [](const CollatedTitle &t) -> const string & { return t.key; });
+  return out;
+}
+
+// whether a title with the same key as title is in a collated list
+inline bool contains_title(const vector<CollatedTitle> &library,
+                           string_view title) {
+  return binary_search(library.begin(), library.end(), collation_key(title),
+                       KeyLess{});
+}
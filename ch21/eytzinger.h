@@ -0,0 +1,153 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * search index for a sorted list of titles, laid out in eytzinger (bfs)
+ * order so the first levels of every search share the same cache lines
+ */
+
+#include "../connor.h"
+#include "key_prefix.h"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string_view>
+
+class EytzingerIndex {
+public:
+  EytzingerIndex() = default;
+
+  // [first, last) must already be sorted
+  template <random_access_iterator Iterator>
+  EytzingerIndex(Iterator first, Iterator last)
+      : n{static_cast<size_t>(last - first)},
+        nodes{make_nodes(n + 1)}, offsets(n + 2) {
+    // node k has children 2k and 2k+1, so an in-order walk of the tree
+    // visits the sorted titles in order
+    vector<size_t> rank(n + 1);
+    size_t next = 0;
+    for_each_in_order(1, [&](size_t k) { rank[k] = next++; });
+
+    // a search only reaches node k when the query lies between two titles
+    // that are already known (the nearest ancestors it went right and left
+    // at), so it shares their common prefix and the node can skip it
+    nodes[0] = {};
+    set_nodes(first, rank, 1, {}, {});
+
+    // the titles themselves go into one buffer in the same order as the
+    // nodes, so a full compare is one jump instead of two
+    for (size_t k = 1; k <= n; ++k)
+      offsets[k + 1] = offsets[k] + first[rank[k]].size();
+    chars.resize(offsets[n + 1]);
+    for (size_t k = 1; k <= n; ++k) {
+      string_view title = first[rank[k]];
+      memcpy(chars.data() + offsets[k], title.data(), title.size());
+    }
+  }
+
+  size_t size() const { return n; }
+
+  bool contains(string_view x) const {
+    size_t k = descend(x);
+    return k && key(k) == x;
+  }
+
+private:
+  // 12 bytes of the title starting at skip, plus skip itself: 16 bytes, so
+  // four nodes to a cache line
+  struct Node {
+    uint64_t hi = 0;
+    uint32_t lo = 0;
+    uint32_t skip = 0;
+  };
+
+  // the nodes come from the aligned operator new[] and go back to the
+  // matching operator delete[]; Node needs no destructor run
+  struct AlignedDelete {
+    void operator()(Node *p) const { operator delete[](p, align_val_t{64}); }
+  };
+  static Node *make_nodes(size_t count) {
+    Node *p = static_cast<Node *>(
+        operator new[](count * sizeof(Node), align_val_t{64}));
+    uninitialized_value_construct_n(p, count);
+    return p;
+  }
+
+  // asks for node k to be brought into cache. k can be past the end near
+  // the leaves, so the address is worked out as a plain number rather
+  // than a pointer into nodes (a prefetch of it never faults)
+  void prefetch(size_t k) const {
+    __builtin_prefetch(reinterpret_cast<const void *>(
+        reinterpret_cast<uintptr_t>(nodes.get()) + k * sizeof(Node)));
+  }
+
+  static unsigned __int128 prefix(string_view s, size_t skip) {
+    return (static_cast<unsigned __int128>(key_prefix(s, skip)) << 32) |
+           (key_prefix(s, skip + 8) >> 32);
+  }
+
+  template <typename F> void for_each_in_order(size_t k, F &&visit) {
+    if (k > n)
+      return;
+    for_each_in_order(2 * k, visit);
+    visit(k);
+    for_each_in_order(2 * k + 1, visit);
+  }
+
+  // lo and hi are the titles at the nearest ancestors the search went right
+  // and left at (empty optional: there is none yet)
+  template <typename Iterator>
+  void set_nodes(Iterator first, const vector<size_t> &rank, size_t k,
+                 optional<string_view> lo, optional<string_view> hi) {
+    if (k > n)
+      return;
+    string_view title = first[rank[k]];
+    size_t skip = 0;
+    if (lo && hi)
+      skip = static_cast<size_t>(
+          mismatch(lo->begin(), lo->end(), hi->begin(), hi->end()).first -
+          lo->begin());
+    unsigned __int128 p = prefix(title, skip);
+    nodes[k] = {static_cast<uint64_t>(p >> 32), static_cast<uint32_t>(p),
+                static_cast<uint32_t>(skip)};
+    set_nodes(first, rank, 2 * k, lo, title);
+    set_nodes(first, rank, 2 * k + 1, title, hi);
+  }
+
+  string_view key(size_t k) const {
+    return {chars.data() + offsets[k], offsets[k + 1] - offsets[k]};
+  }
+
+  // lower bound of x in eytzinger order, 0 if every title is smaller
+  size_t descend(string_view x) const {
+    size_t k = 1;
+    while (k <= n) {
+      // the 8 descendants three levels down sit next to each other (two
+      // cache lines); ask for them now so they arrive by the time we get there
+      prefetch(8 * k);
+      prefetch(8 * k + 4);
+      const Node &node = nodes[k];
+      unsigned __int128 p =
+          (static_cast<unsigned __int128>(node.hi) << 32) | node.lo;
+      unsigned __int128 q = prefix(x, node.skip);
+      // only equal prefixes fall through to the string compare
+      bool go_right = p < q || (p == q && key(k) < x);
+      k = 2 * k + go_right;
+    }
+    // undo the trailing right turns: what is left is the last node where we
+    // went left, i.e. the lower bound (0 if we never went left)
+    return k >> (countr_one(k) + 1);
+  }
+
+  size_t n = 0;
+  unique_ptr<Node[], AlignedDelete> nodes;
+  vector<size_t> offsets;
+  string chars;
+};
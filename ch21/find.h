@@ -0,0 +1,168 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * my_find: the generic linear search plus faster versions for contiguous
+ * ranges (avx2, 32 bytes per step) and for large ranges (split over threads)
+ */
+
+#include "../connor.h"
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MY_FIND_X86 1
+#endif
+
+// generic version: works for any input iterator and any == comparable value
+template <typename Iterator, typename T>
+Iterator my_find(Iterator first, Iterator last, const T &val) {
+  while (first != last && *first != val)
+    ++first;
+  return first;
+}
+
+namespace find_detail {
+
+// element types where == means "same bytes", so a whole register of them
+// can be compared at once. floating point is left out on purpose: -0.0 == 0.0
+// and NaN != NaN would not match a byte compare.
+template <typename E, typename T>
+concept simd_findable =
+    (std::is_integral_v<E> || std::is_enum_v<E> || std::is_pointer_v<E>) &&
+    std::same_as<std::remove_cv_t<E>, std::remove_cv_t<T>> &&
+    (sizeof(E) == 1 || sizeof(E) == 2 || sizeof(E) == 4 || sizeof(E) == 8);
+
+template <typename E> size_t find_scalar(const E *p, size_t n, const E &val) {
+  for (size_t i = 0; i < n; ++i)
+    if (p[i] == val)
+      return i;
+  return n;
+}
+
+#ifdef MY_FIND_X86
+template <typename E>
+__attribute__((target("avx2"))) size_t find_avx2(const E *p, size_t n,
+                                                 const E &val) {
+  constexpr size_t lanes = 32 / sizeof(E);
+  __m256i needle;
+  if constexpr (sizeof(E) == 1) {
+    int8_t bits;
+    memcpy(&bits, &val, 1);
+    needle = _mm256_set1_epi8(bits);
+  } else if constexpr (sizeof(E) == 2) {
+    int16_t bits;
+    memcpy(&bits, &val, 2);
+    needle = _mm256_set1_epi16(bits);
+  } else if constexpr (sizeof(E) == 4) {
+    int32_t bits;
+    memcpy(&bits, &val, 4);
+    needle = _mm256_set1_epi32(bits);
+  } else {
+    long long bits;
+    memcpy(&bits, &val, 8);
+    needle = _mm256_set1_epi64x(bits);
+  }
+
+  size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+    __m256i eq;
+    if constexpr (sizeof(E) == 1)
+      eq = _mm256_cmpeq_epi8(block, needle);
+    else if constexpr (sizeof(E) == 2)
+      eq = _mm256_cmpeq_epi16(block, needle);
+    else if constexpr (sizeof(E) == 4)
+      eq = _mm256_cmpeq_epi32(block, needle);
+    else
+      eq = _mm256_cmpeq_epi64(block, needle);
+    // one mask bit per byte, so the lowest set bit is the first match
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(eq));
+    if (mask)
+      return i + __builtin_ctz(mask) / sizeof(E);
+  }
+  return i + find_scalar(p + i, n - i, val);
+}
+
+inline bool has_avx2() {
+  static const bool ok = __builtin_cpu_supports("avx2");
+  return ok;
+}
+#endif
+
+template <typename E> size_t find_contiguous(const E *p, size_t n, const E &val) {
+#ifdef MY_FIND_X86
+  if (has_avx2())
+    return find_avx2(p, n, val);
+#endif
+  return find_scalar(p, n, val);
+}
+
+} // namespace find_detail
+
+// contiguous ranges of plain integers, enums or pointers (vector<int>, arrays,
+// ...): same result as the generic version, 32 bytes per step when the cpu
+// has avx2
+template <std::contiguous_iterator Iterator, typename T>
+  requires find_detail::simd_findable<std::iter_value_t<Iterator>, T>
+Iterator my_find(Iterator first, Iterator last, const T &val) {
+  using E = std::iter_value_t<Iterator>;
+  const E *p = std::to_address(first);
+  size_t n = static_cast<size_t>(last - first);
+  return first + find_detail::find_contiguous<E>(p, n, val);
+}
+
+// parallel version: the range is cut into one piece per thread, and each
+// piece is scanned in blocks with my_find. the smallest match found so far is
+// shared, and a thread stops as soon as its next block starts after it, so
+// the answer is still the first match in the whole range.
+template <std::random_access_iterator Iterator, typename T>
+Iterator my_find_par(Iterator first, Iterator last, const T &val,
+                     unsigned threads = thread::hardware_concurrency()) {
+  const size_t n = static_cast<size_t>(last - first);
+  const size_t block = 1 << 14;
+  if (threads == 0)
+    threads = 1;
+  if (threads > n / block)
+    threads = static_cast<unsigned>(n / block);
+  if (threads <= 1)
+    return my_find(first, last, val);
+
+  atomic<size_t> best{n};
+  auto scan = [&](size_t begin, size_t end) {
+    for (size_t b = begin; b < end; b += block) {
+      if (best.load(memory_order_relaxed) < b)
+        return; // someone already matched earlier than anything left here
+      size_t e = min(end, b + block);
+      Iterator it = my_find(first + b, first + e, val);
+      if (it != first + e) {
+        size_t pos = static_cast<size_t>(it - first);
+        size_t cur = best.load(memory_order_relaxed);
+        while (pos < cur && !best.compare_exchange_weak(cur, pos))
+          ;
+        return;
+      }
+    }
+  };
+
+  vector<thread> workers;
+  workers.reserve(threads - 1);
+  const size_t piece = (n + threads - 1) / threads;
+  for (unsigned t = 1; t < threads; ++t)
+    workers.emplace_back(scan, min(n, t * piece), min(n, (t + 1) * piece));
+  scan(0, piece); // the first piece runs on this thread
+  for (thread &w : workers)
+    w.join();
+  return first + best.load();
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * inverted index: for each word, the list of titles that contain it, so
+ * "gatsby" finds "The Great Gatsby" without reading every title
+ */
+
+#include "../connor.h"
+#include <cctype>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+// lower case runs of letters and digits; apostrophes are dropped so
+// "Handmaid's" and "handmaids" are the same word
+inline vector<string> title_words(string_view title) {
+  vector<string> words;
+  string word;
+  for (char ch : title) {
+    unsigned char c = static_cast<unsigned char>(ch);
+    if (isalnum(c)) {
+      word += static_cast<char>(tolower(c));
+    } else if (c != '\'' && !word.empty()) {
+      words.push_back(move(word));
+      word.clear();
+    }
+  }
+  if (!word.empty())
+    words.push_back(move(word));
+  return words;
+}
+
+// sorted title numbers for one word, stored as varint gaps in blocks of 64.
+// each block starts with a skip entry holding its first number, so a cursor
+// can jump over whole blocks without decoding them.
+class PostingList {
+public:
+  static constexpr size_t block_size = 64;
+
+  // numbers must be added in increasing order
+  void add(uint32_t doc) {
+    if (count > 0 && doc == last)
+      return; // a word repeated in the same title
+    if (count % block_size == 0) {
+      skips.push_back({doc, static_cast<uint32_t>(bytes.size())});
+    } else {
+      for (uint32_t gap = doc - last;; gap >>= 7) {
+        if (gap < 0x80) {
+          bytes.push_back(static_cast<uint8_t>(gap));
+          break;
+        }
+        bytes.push_back(static_cast<uint8_t>(gap | 0x80));
+      }
+    }
+    last = doc;
+    ++count;
+  }
+
+  size_t size() const { return count; }
+
+  class Cursor {
+  public:
+    explicit Cursor(const PostingList &list) : list{&list} { load(0); }
+
+    bool done() const { return block >= list->skips.size(); }
+    uint32_t doc() const { return docs[pos]; }
+
+    void next() {
+      if (++pos == n)
+        load(block + 1);
+    }
+
+    // move to the first number >= target (never backwards)
+    void seek(uint32_t target) {
+      if (done() || docs[n - 1] >= target) {
+        while (!done() && doc() < target)
+          next();
+        return;
+      }
+      // gallop over the skip entries: 1, 2, 4, ... blocks ahead, then
+      // binary search the last step for the block that can hold target
+      const auto &skips = list->skips;
+      size_t lo = block + 1, step = 1;
+      while (lo + step < skips.size() && skips[lo + step].first <= target) {
+        lo += step;
+        step *= 2;
+      }
+      size_t hi = min(lo + step, skips.size());
+      auto it = upper_bound(
+          skips.begin() + lo, skips.begin() + hi, target,
+          [](uint32_t t, const Skip &s) { return t < s.first; });
+      size_t b = static_cast<size_t>(it - skips.begin());
+      load(b == lo ? lo : b - 1);
+      while (!done() && doc() < target)
+        next();
+    }
+
+  private:
+    void load(size_t b) {
+      block = b;
+      pos = 0;
+      if (done())
+        return;
+      const Skip &s = list->skips[b];
+      n = min(block_size, list->count - b * block_size);
+      const uint8_t *p = list->bytes.data() + s.offset;
+      uint32_t doc = s.first;
+      docs[0] = doc;
+      for (size_t i = 1; i < n; ++i) {
+        uint32_t gap = 0;
+        for (int shift = 0;; shift += 7) {
+          uint8_t byte = *p++;
+          gap |= static_cast<uint32_t>(byte & 0x7f) << shift;
+          if (byte < 0x80)
+            break;
+        }
+        doc += gap;
+        docs[i] = doc;
+      }
+    }
+
+    const PostingList *list;
+    size_t block = 0, pos = 0, n = 0;
+    uint32_t docs[block_size]; // the current block, decoded
+  };
+
+  vector<uint32_t> decode() const {
+    vector<uint32_t> out;
+    out.reserve(count);
+    for (Cursor c{*this}; !c.done(); c.next())
+      out.push_back(c.doc());
+    return out;
+  }
+
+private:
+  struct Skip {
+    uint32_t first;  // first number in the block
+    uint32_t offset; // where the block's gaps start in bytes
+  };
+
+  vector<uint8_t> bytes;
+  vector<Skip> skips;
+  size_t count = 0;
+  uint32_t last = 0;
+};
+
+class InvertedIndex {
+public:
+  InvertedIndex() = default;
+
+  // titles are numbered by their position in [first, last)
+  template <typename Iterator> InvertedIndex(Iterator first, Iterator last) {
+    uint32_t doc = 0;
+    for (; first != last; ++first, ++doc)
+      for (const string &w : title_words(*first))
+        postings[w].add(doc);
+  }
+
+  // titles containing every word of the query
+  vector<uint32_t> search_all(string_view query) const {
+    vector<const PostingList *> lists;
+    for (const string &w : title_words(query)) {
+      auto it = postings.find(w);
+      if (it == postings.end())
+        return {};
+      lists.push_back(&it->second);
+    }
+    if (lists.empty())
+      return {};
+
+    // start from the rarest word and only look up its titles in the others
+    sort(lists.begin(), lists.end(),
+         [](const PostingList *a, const PostingList *b) {
+           return a->size() < b->size();
+         });
+    vector<uint32_t> result = lists[0]->decode();
+    for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+      PostingList::Cursor c{*lists[i]};
+      size_t kept = 0;
+      for (uint32_t doc : result) {
+        c.seek(doc);
+        if (c.done())
+          break;
+        if (c.doc() == doc)
+          result[kept++] = doc;
+      }
+      result.resize(kept);
+    }
+    return result;
+  }
+
+  // titles containing at least one word of the query
+  vector<uint32_t> search_any(string_view query) const {
+    vector<uint32_t> result;
+    for (const string &w : title_words(query)) {
+      auto it = postings.find(w);
+      if (it == postings.end())
+        continue;
+      vector<uint32_t> docs = it->second.decode();
+      vector<uint32_t> merged;
+      merged.reserve(result.size() + docs.size());
+      set_union(result.begin(), result.end(), docs.begin(), docs.end(),
+                back_inserter(merged));
+      result = move(merged);
+    }
+    return result;
+  }
+
+private:
+  unordered_map<string, PostingList> postings;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * fixed-width key prefixes for comparing titles a word at a time
+ */
+
+#include "../connor.h"
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// 8 bytes of a string starting at pos, as a big-endian number, zero padded
+// past the end. if two prefixes differ they order the strings the same way
+// string::compare does; only equal prefixes need the full compare.
+inline uint64_t key_prefix(string_view s, size_t pos = 0) {
+  uint64_t p = 0;
+  if (pos < s.size())
+    memcpy(&p, s.data() + pos, min<size_t>(s.size() - pos, 8));
+  return __builtin_bswap64(p);
+}
@@ -0,0 +1,300 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * relevance ranked search: bm25 scores over titles and descriptions, top k
+ * results only. lists that cannot lift a document into the top k on their
+ * own are only probed for candidates from the others, and block maxima skip
+ * most of those probes, so most postings are never scored.
+ */
+
+#include "../connor.h"
+#include "inverted_index.h"
+#include <cmath>
+#include <cstdint>
+#include <queue>
+#include <string_view>
+#include <unordered_map>
+
+struct SearchHit {
+  uint32_t doc;
+  float score;
+};
+
+// how much work a query did, for the benchmark
+struct RankStats {
+  size_t scored = 0; // documents fully scored
+};
+
+class Bm25Index {
+public:
+  static constexpr float k1 = 1.2f, b = 0.75f;
+  static constexpr size_t block_size = 64;
+
+  // documents are numbered in the order they are added
+  void add(string_view text) {
+    uint32_t doc = static_cast<uint32_t>(lengths.size());
+    vector<string> words = title_words(text);
+    lengths.push_back(static_cast<uint32_t>(words.size()));
+    sort(words.begin(), words.end());
+    for (size_t i = 0; i < words.size();) {
+      size_t j = i;
+      while (j < words.size() && words[j] == words[i])
+        ++j;
+      auto [it, added] = term_ids.try_emplace(words[i], terms.size());
+      if (added)
+        terms.emplace_back();
+      // the score slot holds the raw term count until finish()
+      terms[it->second].postings.push_back({doc, static_cast<float>(j - i)});
+      i = j;
+    }
+  }
+
+  // turns the term counts into bm25 scores; call once after the last add
+  void finish() {
+    double total = 0;
+    for (uint32_t len : lengths)
+      total += len;
+    const double n = static_cast<double>(lengths.size());
+    const double avgdl = n > 0 ? max(total / n, 1.0) : 1.0;
+
+    for (Term &t : terms) {
+      const double df = static_cast<double>(t.postings.size());
+      const double idf = log(1 + (n - df + 0.5) / (df + 0.5));
+      for (size_t i = 0; i < t.postings.size(); ++i) {
+        Posting &p = t.postings[i];
+        double tf = p.score;
+        double norm = k1 * (1 - b + b * lengths[p.doc] / avgdl);
+        p.score = static_cast<float>(idf * tf * (k1 + 1) / (tf + norm));
+        if (i % block_size == 0) {
+          t.block_max.push_back(0);
+          t.block_last.push_back(0);
+        }
+        t.block_max.back() = max(t.block_max.back(), p.score);
+        t.block_last.back() = p.doc;
+        t.max_score = max(t.max_score, p.score);
+      }
+    }
+  }
+
+  size_t size() const { return lengths.size(); }
+
+  // the k best documents for the query, best first
+  vector<SearchHit> top_k(string_view query, size_t k,
+                          RankStats *stats = nullptr) const {
+    vector<Cursor> cursors = open(query);
+    TopK best{k};
+    if (k == 0)
+      return {};
+
+    // lists by their best possible score, lowest first. bound[i] is the most
+    // lists 0..i can add to any document together.
+    sort(cursors.begin(), cursors.end(), [](const Cursor &x, const Cursor &y) {
+      return x.term->max_score < y.term->max_score;
+    });
+    const size_t m = cursors.size();
+    vector<float> bound(m);
+    for (size_t i = 0; i < m; ++i)
+      bound[i] = cursors[i].term->max_score + (i ? bound[i - 1] : 0);
+
+    // lists 0..first-1 cannot put a document into the top k on their own, so
+    // only the documents of the other ("essential") lists are candidates
+    size_t first = 0;
+    while (true) {
+      const float theta = best.threshold();
+      while (first < m && bound[first] <= theta)
+        ++first;
+      if (first == m)
+        break; // nothing left can make the top k
+
+      uint32_t doc = UINT32_MAX;
+      for (size_t i = first; i < m; ++i)
+        doc = min(doc, cursors[i].doc());
+      if (doc == UINT32_MAX)
+        break;
+
+      float score = 0;
+      for (size_t i = first; i < m; ++i) {
+        if (cursors[i].doc() == doc) {
+          score += cursors[i].score();
+          cursors[i].next();
+        }
+      }
+
+      // block-max check: the blocks the other lists have around doc usually
+      // bound them much lower than max_score
+      if (first > 0) {
+        float block_bound = score;
+        for (size_t i = 0; i < first; ++i) {
+          cursors[i].seek(doc);
+          block_bound += cursors[i].block_max();
+        }
+        if (block_bound <= theta)
+          continue;
+      }
+
+      // add the other lists, best first, while the rest could still matter
+      for (size_t i = first; i-- > 0 && score + bound[i] > theta;)
+        if (cursors[i].doc() == doc)
+          score += cursors[i].score();
+      if (stats)
+        ++stats->scored;
+      best.push({doc, score});
+    }
+    return best.sorted();
+  }
+
+  // same answer as top_k, but scores every document that has a query word.
+  // kept as the baseline for the benchmark.
+  vector<SearchHit> top_k_exhaustive(string_view query, size_t k,
+                                     RankStats *stats = nullptr) const {
+    vector<Cursor> cursors = open(query);
+    TopK best{k};
+    if (k == 0)
+      return {};
+    while (true) {
+      uint32_t doc = UINT32_MAX;
+      for (const Cursor &c : cursors)
+        doc = min(doc, c.doc());
+      if (doc == UINT32_MAX)
+        break;
+      float score = 0;
+      for (Cursor &c : cursors) {
+        if (c.doc() == doc) {
+          score += c.score();
+          c.next();
+        }
+      }
+      if (stats)
+        ++stats->scored;
+      best.push({doc, score});
+    }
+    return best.sorted();
+  }
+
+private:
+  struct Posting {
+    uint32_t doc;
+    float score;
+  };
+
+  struct Term {
+    vector<Posting> postings;
+    vector<float> block_max;     // best score in each block of postings
+    vector<uint32_t> block_last; // last document in each block
+    float max_score = 0;
+  };
+
+  struct Cursor {
+    const Term *term;
+    size_t pos = 0;
+
+    bool done() const { return pos == term->postings.size(); }
+    uint32_t doc() const {
+      return done() ? UINT32_MAX : term->postings[pos].doc;
+    }
+    float score() const { return term->postings[pos].score; }
+    void next() { ++pos; }
+
+    // the block that holds the first posting >= target, galloping over the
+    // blocks from the current one (block_last.size() if there is none)
+    size_t block_of(uint32_t target) const {
+      const vector<uint32_t> &last = term->block_last;
+      size_t lo = pos / block_size;
+      if (lo >= last.size() || last[lo] >= target)
+        return lo;
+      size_t step = 1;
+      while (lo + step < last.size() && last[lo + step] < target) {
+        lo += step;
+        step *= 2;
+      }
+      return static_cast<size_t>(
+          std::lower_bound(last.begin() + lo,
+                           last.begin() + min(lo + step + 1, last.size()),
+                           target) -
+          last.begin());
+    }
+
+    // best score in the block the cursor is in
+    float block_max() const {
+      return done() ? 0 : term->block_max[pos / block_size];
+    }
+
+    // move to the first posting >= target
+    void seek(uint32_t target) {
+      if (done() || doc() >= target)
+        return;
+      const vector<Posting> &ps = term->postings;
+      size_t blk = block_of(target);
+      if (blk == term->block_last.size()) {
+        pos = ps.size();
+        return;
+      }
+      auto first = ps.begin() + max(pos, blk * block_size);
+      auto last = ps.begin() + min(ps.size(), (blk + 1) * block_size);
+      pos = static_cast<size_t>(
+          std::lower_bound(first, last, target,
+                           [](const Posting &p, uint32_t t) {
+                             return p.doc < t;
+                           }) -
+          ps.begin());
+    }
+  };
+
+  // min-heap of the k best hits seen so far
+  class TopK {
+  public:
+    explicit TopK(size_t k) : k{k} {}
+
+    // a new hit has to beat this to get in
+    float threshold() const {
+      return heap.size() < k ? 0.0f : heap.top().score;
+    }
+
+    void push(SearchHit hit) {
+      if (heap.size() < k) {
+        heap.push(hit);
+      } else if (hit.score > heap.top().score) {
+        heap.pop();
+        heap.push(hit);
+      }
+    }
+
+    vector<SearchHit> sorted() {
+      vector<SearchHit> out;
+      for (; !heap.empty(); heap.pop())
+        out.push_back(heap.top());
+      reverse(out.begin(), out.end());
+      return out;
+    }
+
+  private:
+    struct Worse {
+      bool operator()(const SearchHit &a, const SearchHit &b) const {
+        return a.score > b.score;
+      }
+    };
+    size_t k;
+    priority_queue<SearchHit, vector<SearchHit>, Worse> heap;
+  };
+
+  vector<Cursor> open(string_view query) const {
+    vector<string> words = title_words(query);
+    sort(words.begin(), words.end());
+    words.erase(unique(words.begin(), words.end()), words.end());
+    vector<Cursor> cursors;
+    for (const string &w : words) {
+      auto it = term_ids.find(w);
+      if (it != term_ids.end())
+        cursors.push_back({&terms[it->second]});
+    }
+    return cursors;
+  }
+
+  unordered_map<string, uint32_t> term_ids;
+  vector<Term> terms;
+  vector<uint32_t> lengths; // words per document
+};
@@ -0,0 +1,159 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * a list of titles kept in one char buffer instead of one heap block per
+ * title. each entry holds the title's first 8 bytes as a number, so scans,
+ * sorts and searches mostly read the entries and not the characters.
+ */
+
+#include "../connor.h"
+#include "key_prefix.h"
+#include <compare>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <ostream>
+#include <string_view>
+
+// one title in a StringPool: its prefix, where its characters are, and its
+// length. it compares like a string_view, but two titles whose prefixes
+// differ are ordered without reading either one's characters.
+class PooledString {
+public:
+  PooledString() = default;
+
+  // a search key for the algorithms below: points at s, which has to stay
+  // alive while it is used
+  explicit PooledString(string_view s)
+      : pre{key_prefix(s)}, ptr{s.data()},
+        len{static_cast<uint32_t>(s.size())} {}
+
+  operator string_view() const { return {ptr, len}; }
+  const char *data() const { return ptr; }
+  size_t size() const { return len; }
+  uint64_t prefix() const { return pre; }
+
+  friend bool operator==(const PooledString &a, const PooledString &b) {
+    return a.pre == b.pre && a.len == b.len &&
+           (a.len <= 8 ||
+            string_view{a}.substr(8) == string_view{b}.substr(8));
+  }
+
+  friend strong_ordering operator<=>(const PooledString &a,
+                                     const PooledString &b) {
+    if (a.pre != b.pre)
+      return a.pre <=> b.pre;
+    // same first 8 bytes (zero padded): if either is that short, it is a
+    // prefix of the other
+    if (a.len <= 8 || b.len <= 8)
+      return a.len <=> b.len;
+    return string_view{a}.substr(8) <=> string_view{b}.substr(8);
+  }
+
+  // plain strings compare by their characters; for many lookups with the
+  // same string, wrap it in a PooledString once instead
+  friend bool operator==(const PooledString &a, string_view b) {
+    return string_view{a} == b;
+  }
+  friend strong_ordering operator<=>(const PooledString &a, string_view b) {
+    return string_view{a} <=> b;
+  }
+
+  friend ostream &operator<<(ostream &out, const PooledString &s) {
+    return out << string_view{s};
+  }
+
+private:
+  friend class StringPool;
+
+  uint64_t pre = 0;
+  const char *ptr = nullptr;
+  uint32_t len = 0;
+};
+
+class StringPool {
+public:
+  using value_type = PooledString;
+  using iterator = vector<PooledString>::iterator;
+  using const_iterator = vector<PooledString>::const_iterator;
+
+  StringPool() = default;
+
+  template <typename Iterator> StringPool(Iterator first, Iterator last) {
+    if constexpr (forward_iterator<Iterator>) {
+      size_t total = 0;
+      for (Iterator it = first; it != last; ++it)
+        total += string_view{*it}.size();
+      reserve(static_cast<size_t>(distance(first, last)), total);
+    }
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+
+  StringPool(initializer_list<string_view> titles)
+      : StringPool(titles.begin(), titles.end()) {}
+
+  // the entries point into chars, so a copy has to point them at its own
+  StringPool(const StringPool &other)
+      : chars{other.chars}, entries{other.entries} {
+    rebase(other.chars.data());
+  }
+  StringPool(StringPool &&other) noexcept = default;
+  StringPool &operator=(StringPool other) noexcept {
+    chars.swap(other.chars);
+    entries.swap(other.entries);
+    return *this;
+  }
+
+  void reserve(size_t titles, size_t total_chars) {
+    entries.reserve(titles);
+    grow(total_chars);
+  }
+
+  void push_back(string_view s) {
+    if (chars.size() + s.size() > chars.capacity())
+      grow(max(chars.size() + s.size(), 2 * chars.capacity()));
+    size_t at = chars.size();
+    chars.insert(chars.end(), s.begin(), s.end());
+    entries.emplace_back(string_view{chars.data() + at, s.size()});
+  }
+
+  size_t size() const { return entries.size(); }
+  bool empty() const { return entries.empty(); }
+  const PooledString &operator[](size_t i) const { return entries[i]; }
+
+  // sort, reverse and the like rearrange the entries; the characters stay
+  // where they are
+  iterator begin() { return entries.begin(); }
+  iterator end() { return entries.end(); }
+  const_iterator begin() const { return entries.begin(); }
+  const_iterator end() const { return entries.end(); }
+
+  // bytes of characters held
+  size_t char_bytes() const { return chars.size(); }
+
+private:
+  // chars moves when it grows, and the entries have to follow it
+  void grow(size_t capacity) {
+    if (capacity <= chars.capacity())
+      return;
+    vector<char> bigger;
+    bigger.reserve(capacity);
+    bigger.assign(chars.begin(), chars.end());
+    const char *old = chars.data();
+    chars.swap(bigger);
+    rebase(old);
+  }
+
+  void rebase(const char *old) {
+    for (PooledString &e : entries)
+      e.ptr = chars.data() + (e.ptr - old);
+  }
+
+  vector<char> chars;
+  vector<PooledString> entries;
+};
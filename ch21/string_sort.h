@@ -0,0 +1,183 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * string_sort: multikey quicksort for lists of titles. it looks at the
+ * strings 8 characters at a time through a cached copy, so a shared "The "
+ * is compared once per group instead of once per comparison.
+ */
+
+#include "../connor.h"
+#include "key_prefix.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+namespace string_sort_detail {
+
+struct Entry {
+  uint64_t cache; // 8 characters starting at the current depth
+  const char *data;
+  size_t size;
+  size_t index; // where the element was in the input
+};
+
+inline string_view rest(const Entry &e, size_t depth) {
+  return {e.data + min(depth, e.size), e.size - min(depth, e.size)};
+}
+
+// everything before depth is already known to be equal
+inline bool less_from(const Entry &a, const Entry &b, size_t depth) {
+  if (a.cache != b.cache)
+    return a.cache < b.cache;
+  return rest(a, depth) < rest(b, depth);
+}
+
+inline void insertion_sort(Entry *lo, Entry *hi, size_t depth) {
+  for (Entry *i = lo + 1; i < hi; ++i) {
+    Entry e = *i;
+    Entry *j = i;
+    for (; j > lo && less_from(e, j[-1], depth); --j)
+      *j = j[-1];
+    *j = e;
+  }
+}
+
+// hands big sub-ranges to other threads; small ones are sorted in place
+class Pool {
+public:
+  struct Task {
+    Entry *lo, *hi;
+    size_t depth;
+  };
+
+  explicit Pool(unsigned threads) : threads{threads} {}
+
+  bool parallel() const { return threads > 1; }
+
+  void push(Task t) {
+    lock_guard<mutex> lk{m};
+    tasks.push_back(t);
+    ++pending;
+    cv.notify_one();
+  }
+
+  template <typename F> void run(F &&sort_task) {
+    auto work = [&] {
+      unique_lock<mutex> lk{m};
+      while (true) {
+        cv.wait(lk, [&] { return !tasks.empty() || pending == 0; });
+        if (tasks.empty())
+          return; // nothing queued and nothing running: all done
+        Task t = tasks.back();
+        tasks.pop_back();
+        lk.unlock();
+        sort_task(t);
+        lk.lock();
+        if (--pending == 0)
+          cv.notify_all();
+      }
+    };
+    vector<thread> workers;
+    for (unsigned i = 1; i < threads; ++i)
+      workers.emplace_back(work);
+    work();
+    for (thread &w : workers)
+      w.join();
+  }
+
+private:
+  unsigned threads;
+  mutex m;
+  condition_variable cv;
+  vector<Task> tasks;
+  size_t pending = 0;
+};
+
+const size_t spawn_size = 1 << 14;
+
+inline void mkqs(Entry *lo, Entry *hi, size_t depth, Pool &pool) {
+  while (hi - lo > 16) {
+    // median of three cached words as the pivot
+    uint64_t a = lo->cache, b = lo[(hi - lo) / 2].cache, c = hi[-1].cache;
+    uint64_t pivot = max(min(a, b), min(max(a, b), c));
+
+    // three-way partition: [lo, lt) < pivot, [lt, gt) == pivot, [gt, hi) >
+    Entry *lt = lo, *i = lo, *gt = hi;
+    while (i < gt) {
+      if (i->cache < pivot)
+        swap(*lt++, *i++);
+      else if (i->cache > pivot)
+        swap(*i, *--gt);
+      else
+        ++i;
+    }
+
+    for (auto [l, h] : {pair{lo, lt}, pair{gt, hi}}) {
+      if (pool.parallel() && h - l >= static_cast<ptrdiff_t>(spawn_size))
+        pool.push({l, h, depth});
+      else
+        mkqs(l, h, depth, pool);
+    }
+
+    // the middle group agrees on 8 more characters. strings that ended inside
+    // them are prefixes of the others and equal to each other except for
+    // trailing '\0's, so they go first, shortest first.
+    Entry *next = partition(lt, gt, [&](const Entry &e) {
+      return e.size <= depth + 8;
+    });
+    sort(lt, next, [](const Entry &x, const Entry &y) {
+      return x.size < y.size;
+    });
+    depth += 8;
+    for (Entry *e = next; e < gt; ++e)
+      e->cache = key_prefix({e->data, e->size}, depth);
+    lo = next;
+    hi = gt;
+  }
+  insertion_sort(lo, hi, depth);
+}
+
+} // namespace string_sort_detail
+
+// sorts [first, last) into the same order as sort() with <, comparing
+// proj(element) as strings. proj must return something that stays valid
+// while sorting (a string&, or a string_view into the element).
+template <random_access_iterator Iterator, typename Proj = identity>
+void string_sort(Iterator first, Iterator last, Proj proj = {},
+                 unsigned threads = thread::hardware_concurrency()) {
+  using namespace string_sort_detail;
+  const size_t n = static_cast<size_t>(last - first);
+  if (n < 2)
+    return;
+  if (threads == 0 || n < 2 * spawn_size)
+    threads = 1;
+
+  vector<Entry> entries(n);
+  for (size_t i = 0; i < n; ++i) {
+    string_view key = invoke(proj, first[i]);
+    entries[i] = {key_prefix(key), key.data(), key.size(), i};
+  }
+
+  Pool pool{threads};
+  if (pool.parallel()) {
+    pool.push({entries.data(), entries.data() + n, 0});
+    pool.run([&](const Pool::Task &t) { mkqs(t.lo, t.hi, t.depth, pool); });
+  } else {
+    mkqs(entries.data(), entries.data() + n, 0, pool);
+  }
+
+  // put the elements themselves in order
+  vector<iter_value_t<Iterator>> sorted;
+  sorted.reserve(n);
+  for (const Entry &e : entries)
+    sorted.push_back(move(first[e.index]));
+  move(sorted.begin(), sorted.end(), first);
+}
@@ -0,0 +1,268 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * SmallVector: a vector that keeps its first N values inside itself and
+ * only goes to the heap once it grows past N. for the short lists in the
+ * homework (7 ints, 10 presidents) the list itself never needs a heap
+ * block (long strings in it still allocate their own chars). it has
+ * vector's interface, so it drops in where a vector was.
+ */
+
+#include "connor.h"
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+template <typename T, size_t N> class SmallVector {
+  static_assert(N > 0, "use vector when nothing should be kept inline");
+
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using iterator = T *;
+  using const_iterator = const T *;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  SmallVector() = default;
+  explicit SmallVector(size_t count) { resize(count); }
+  SmallVector(size_t count, const T &v) { insert(end(), count, v); }
+  template <typename It, typename = typename iterator_traits<It>::value_type>
+  SmallVector(It first, It last) {
+    insert(end(), first, last);
+  }
+  SmallVector(initializer_list<T> values)
+      : SmallVector(values.begin(), values.end()) {}
+  SmallVector(const SmallVector &other)
+      : SmallVector(other.begin(), other.end()) {}
+  SmallVector(SmallVector &&other) noexcept { take(other); }
+  ~SmallVector() {
+    clear();
+    release();
+  }
+
+  SmallVector &operator=(const SmallVector &other) {
+    if (this != &other)
+      assign(other.begin(), other.end());
+    return *this;
+  }
+  SmallVector &operator=(SmallVector &&other) noexcept {
+    if (this != &other) {
+      clear();
+      release();
+      take(other);
+    }
+    return *this;
+  }
+  SmallVector &operator=(initializer_list<T> values) {
+    assign(values.begin(), values.end());
+    return *this;
+  }
+
+  template <typename It> void assign(It first, It last) {
+    clear();
+    insert(end(), first, last);
+  }
+
+  size_t size() const { return n; }
+  size_t capacity() const { return cap; }
+  bool empty() const { return n == 0; }
+  // true while the values are still inside the SmallVector itself
+  bool is_small() const { return ptr == inline_values(); }
+
+  T *data() { return ptr; }
+  const T *data() const { return ptr; }
+  T &operator[](size_t i) { return ptr[i]; }
+  const T &operator[](size_t i) const { return ptr[i]; }
+  T &at(size_t i) {
+    if (i >= n)
+      throw out_of_range("SmallVector::at");
+    return ptr[i];
+  }
+  const T &at(size_t i) const {
+    return const_cast<SmallVector *>(this)->at(i);
+  }
+  T &front() { return ptr[0]; }
+  const T &front() const { return ptr[0]; }
+  T &back() { return ptr[n - 1]; }
+  const T &back() const { return ptr[n - 1]; }
+
+  iterator begin() { return ptr; }
+  iterator end() { return ptr + n; }
+  const_iterator begin() const { return ptr; }
+  const_iterator end() const { return ptr + n; }
+  const_iterator cbegin() const { return ptr; }
+  const_iterator cend() const { return ptr + n; }
+  reverse_iterator rbegin() { return reverse_iterator{end()}; }
+  reverse_iterator rend() { return reverse_iterator{begin()}; }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator{end()};
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator{begin()};
+  }
+
+  void reserve(size_t want) {
+    if (want > cap)
+      move_to(allocate(want), want);
+  }
+
+  void resize(size_t count) {
+    reserve(count);
+    while (n > count)
+      pop_back();
+    for (; n < count; ++n)
+      new (ptr + n) T();
+  }
+
+  void clear() {
+    destroy(ptr, ptr + n);
+    n = 0;
+  }
+
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (n == cap) {
+      // args may refer to a value in here, so build the new one first
+      size_t new_cap = grown(n + 1);
+      T *fresh = allocate(new_cap);
+      new (fresh + n) T(std::forward<Args>(args)...);
+      move_to(fresh, new_cap);
+    } else {
+      new (ptr + n) T(std::forward<Args>(args)...);
+    }
+    return ptr[n++];
+  }
+  void push_back(const T &v) { emplace_back(v); }
+  void push_back(T &&v) { emplace_back(move(v)); }
+  void pop_back() { ptr[--n].~T(); }
+
+  // puts a value made from args before pos; returns its position
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    size_t at = static_cast<size_t>(pos - begin());
+    if (at == n) {
+      emplace_back(std::forward<Args>(args)...);
+      return begin() + at;
+    }
+    T v(std::forward<Args>(args)...); // args may refer to a value in here
+    reserve(grown(n + 1));
+    new (ptr + n) T(move(ptr[n - 1]));
+    move_backward(ptr + at, ptr + n - 1, ptr + n);
+    ptr[at] = move(v);
+    ++n;
+    return begin() + at;
+  }
+  iterator insert(const_iterator pos, const T &v) { return emplace(pos, v); }
+  iterator insert(const_iterator pos, T &&v) { return emplace(pos, move(v)); }
+
+  iterator insert(const_iterator pos, size_t count, const T &v) {
+    T copy = v;
+    size_t at = static_cast<size_t>(pos - begin());
+    size_t old = n;
+    for (size_t i = 0; i < count; ++i)
+      push_back(copy);
+    rotate(begin() + at, begin() + old, end());
+    return begin() + at;
+  }
+  template <typename It, typename = typename iterator_traits<It>::value_type>
+  iterator insert(const_iterator pos, It first, It last) {
+    size_t at = static_cast<size_t>(pos - begin());
+    size_t old = n;
+    if constexpr (is_base_of_v<forward_iterator_tag,
+                               typename iterator_traits<It>::iterator_category>)
+      reserve(grown(n + static_cast<size_t>(distance(first, last))));
+    for (; first != last; ++first)
+      emplace_back(*first);
+    rotate(begin() + at, begin() + old, end());
+    return begin() + at;
+  }
+  iterator insert(const_iterator pos, initializer_list<T> values) {
+    return insert(pos, values.begin(), values.end());
+  }
+
+  // removes the value at pos; returns the position of the one after it
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last) {
+    iterator f = begin() + (first - begin());
+    iterator l = begin() + (last - begin());
+    iterator new_end = move(l, end(), f);
+    destroy(new_end, end());
+    n = static_cast<size_t>(new_end - begin());
+    return f;
+  }
+
+  void swap(SmallVector &other) noexcept {
+    SmallVector tmp{move(other)};
+    other = move(*this);
+    *this = move(tmp);
+  }
+
+  friend bool operator==(const SmallVector &a, const SmallVector &b) {
+    return equal(a.begin(), a.end(), b.begin(), b.end());
+  }
+  friend auto operator<=>(const SmallVector &a, const SmallVector &b) {
+    return lexicographical_compare_three_way(a.begin(), a.end(), b.begin(),
+                                             b.end());
+  }
+
+private:
+  T *inline_values() { return reinterpret_cast<T *>(buf); }
+  const T *inline_values() const { return reinterpret_cast<const T *>(buf); }
+
+  // at least double, like vector, so push_back stays O(1) on average
+  size_t grown(size_t want) const {
+    return want <= cap ? cap : max(want, 2 * cap);
+  }
+
+  static T *allocate(size_t count) { return allocator<T>{}.allocate(count); }
+
+  // gives the heap block back, if there is one; the values must be gone
+  void release() {
+    if (!is_small())
+      allocator<T>{}.deallocate(ptr, cap);
+    ptr = inline_values();
+    cap = N;
+  }
+
+  // moves the values into fresh, a new heap block of new_cap values
+  void move_to(T *fresh, size_t new_cap) {
+    uninitialized_move(ptr, ptr + n, fresh);
+    destroy(ptr, ptr + n);
+    release();
+    ptr = fresh;
+    cap = new_cap;
+  }
+
+  // other's heap block, if it has one, just changes hands. inline values
+  // have to be moved one by one.
+  void take(SmallVector &other) {
+    if (other.is_small()) {
+      uninitialized_move(other.begin(), other.end(), ptr);
+      n = other.n;
+      other.clear();
+    } else {
+      ptr = exchange(other.ptr, other.inline_values());
+      cap = exchange(other.cap, N);
+      n = exchange(other.n, 0);
+    }
+  }
+
+  alignas(T) unsigned char buf[N * sizeof(T)];
+  T *ptr = inline_values();
+  size_t n = 0;
+  size_t cap = N;
+};
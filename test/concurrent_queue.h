@@ -0,0 +1,183 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * ConcurrentQueue: a chain of Link-style nodes that any number of threads
+ * can push to and pop from at once without a lock (the Michael-Scott
+ * queue). threads change the links with compare-and-swap, and a node is
+ * only deleted once no thread has it marked as in use (hazard pointers).
+ */
+
+#include "connor.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+template <typename T = string> class ConcurrentQueue {
+  struct Node {
+    Node() = default;
+    explicit Node(T v) : value{move(v)} {}
+    T value;
+    atomic<Node *> succ{nullptr};
+  };
+  struct Record;
+
+public:
+  static constexpr size_t max_threads = 128;
+
+  // what one thread needs to use the queue: its hazard pointers and the
+  // nodes it has taken out but not deleted yet. get one per thread with
+  // handle(); it gives its slot back when it goes away.
+  class Handle {
+  public:
+    Handle(const Handle &) = delete;
+    Handle &operator=(const Handle &) = delete;
+    Handle(Handle &&other) noexcept
+        : queue{exchange(other.queue, nullptr)}, rec{other.rec} {}
+    ~Handle() {
+      if (!queue)
+        return;
+      queue->scan(*rec);
+      rec->active.store(false);
+    }
+
+  private:
+    friend class ConcurrentQueue;
+    Handle(ConcurrentQueue *q, Record *r) : queue{q}, rec{r} {}
+    ConcurrentQueue *queue;
+    Record *rec;
+  };
+
+  ConcurrentQueue() {
+    Node *dummy = new Node;
+    head.store(dummy);
+    tail.store(dummy);
+  }
+  ConcurrentQueue(const ConcurrentQueue &) = delete;
+  ConcurrentQueue &operator=(const ConcurrentQueue &) = delete;
+
+  // no handles may be left when the queue goes away
+  ~ConcurrentQueue() {
+    for (Node *p = head.load(); p;) {
+      Node *next = p->succ.load();
+      delete p;
+      p = next;
+    }
+    for (Record &r : records)
+      for (Node *p : r.retired)
+        delete p;
+  }
+
+  Handle handle() {
+    for (Record &r : records) {
+      bool was = false;
+      if (!r.active.load() && r.active.compare_exchange_strong(was, true))
+        return Handle{this, &r};
+    }
+    throw runtime_error("ConcurrentQueue: more than max_threads handles");
+  }
+
+  void push(Handle &h, T v) {
+    Node *n = new Node{move(v)};
+    while (true) {
+      Node *t = protect(*h.rec, 0, tail);
+      Node *next = t->succ.load();
+      if (t != tail.load())
+        continue;
+      if (next != nullptr) {
+        tail.compare_exchange_weak(t, next); // help a push that stalled
+        continue;
+      }
+      if (t->succ.compare_exchange_weak(next, n)) {
+        tail.compare_exchange_strong(t, n);
+        break;
+      }
+    }
+    // dropping a hazard pointer needs no fence, only setting one does
+    h.rec->hazard[0].store(nullptr, memory_order_release);
+  }
+
+  // false if the queue was empty
+  bool pop(Handle &h, T &out) {
+    Record &rec = *h.rec;
+    while (true) {
+      Node *first = protect(rec, 0, head);
+      Node *t = tail.load();
+      Node *next = first->succ.load();
+      rec.hazard[1].store(next);
+      if (head.load() != first)
+        continue; // first may have been freed, and next with it
+      if (next == nullptr) {
+        rec.hazard[0].store(nullptr, memory_order_release);
+        rec.hazard[1].store(nullptr, memory_order_release);
+        return false;
+      }
+      if (first == t) {
+        tail.compare_exchange_weak(t, next);
+        continue;
+      }
+      if (head.compare_exchange_weak(first, next)) {
+        // next is the new dummy node, and only the thread that moved head
+        // onto it ever reads its value
+        out = move(next->value);
+        rec.hazard[0].store(nullptr, memory_order_release);
+        rec.hazard[1].store(nullptr, memory_order_release);
+        retire(rec, first);
+        return true;
+      }
+    }
+  }
+
+private:
+  struct alignas(64) Record {
+    atomic<bool> active{false};
+    atomic<Node *> hazard[2] = {nullptr, nullptr};
+    vector<Node *> retired; // only touched by the thread holding the record
+  };
+
+  // reads src into hazard slot i, again until the value is stable, so the
+  // node can't be deleted between reading and marking it
+  static Node *protect(Record &rec, int i, atomic<Node *> &src) {
+    Node *p = src.load();
+    while (true) {
+      rec.hazard[i].store(p);
+      Node *again = src.load();
+      if (again == p)
+        return p;
+      p = again;
+    }
+  }
+
+  void retire(Record &rec, Node *n) {
+    rec.retired.push_back(n);
+    if (rec.retired.size() >= 4 * max_threads)
+      scan(rec);
+  }
+
+  // deletes the retired nodes no thread has a hazard pointer on
+  void scan(Record &rec) {
+    vector<Node *> in_use;
+    for (Record &r : records)
+      for (atomic<Node *> &hp : r.hazard)
+        if (Node *p = hp.load())
+          in_use.push_back(p);
+    sort(in_use.begin(), in_use.end());
+    vector<Node *> keep;
+    for (Node *p : rec.retired) {
+      if (binary_search(in_use.begin(), in_use.end(), p))
+        keep.push_back(p);
+      else
+        delete p;
+    }
+    rec.retired = move(keep);
+  }
+
+  alignas(64) atomic<Node *> head;
+  alignas(64) atomic<Node *> tail;
+  Record records[max_threads];
+};
@@ -0,0 +1,175 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * IntrusiveList: a doubly linked list like Link, but the prev/succ
+ * pointers live inside the objects themselves. putting an object on a list
+ * allocates nothing, and an object with several hooks can be on several
+ * lists at once.
+ */
+
+#include "connor.h"
+#include <cstddef>
+#include <iterator>
+
+// derive from ListHook<Tag> once per list an object can be on:
+//   struct Book : ListHook<ByTitle>, ListHook<OnLoan> { ... };
+//   IntrusiveList<Book, ByTitle> shelf;
+// an object has to be taken off its lists before it is destroyed
+template <typename Tag = void> struct ListHook {
+  ListHook() = default;
+  // a copy is a different object, so it starts out on no list
+  ListHook(const ListHook &) {}
+  ListHook &operator=(const ListHook &) { return *this; }
+
+  bool linked() const { return succ != nullptr; }
+
+  ListHook *prev = nullptr;
+  ListHook *succ = nullptr;
+};
+
+template <typename T, typename Tag = void> class IntrusiveList {
+  using Hook = ListHook<Tag>;
+
+public:
+  template <bool Const> class Iterator {
+  public:
+    using iterator_category = bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = conditional_t<Const, const T *, T *>;
+    using reference = conditional_t<Const, const T &, T &>;
+
+    Iterator() = default;
+    // iterator -> const_iterator
+    template <bool C = Const, typename = enable_if_t<C>>
+    Iterator(const Iterator<false> &other) : hook{other.hook} {}
+
+    reference operator*() const { return *owner(hook); }
+    pointer operator->() const { return owner(hook); }
+
+    Iterator &operator++() {
+      hook = hook->succ;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator old = *this;
+      hook = hook->succ;
+      return old;
+    }
+    Iterator &operator--() {
+      hook = hook->prev;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator old = *this;
+      hook = hook->prev;
+      return old;
+    }
+
+    bool operator==(const Iterator &o) const { return hook == o.hook; }
+
+  private:
+    friend class IntrusiveList;
+    friend class Iterator<!Const>;
+    explicit Iterator(Hook *h) : hook{h} {}
+    Hook *hook = nullptr;
+  };
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  IntrusiveList() { head.prev = head.succ = &head; }
+  IntrusiveList(const IntrusiveList &) = delete;
+  IntrusiveList &operator=(const IntrusiveList &) = delete;
+  IntrusiveList(IntrusiveList &&other) noexcept : IntrusiveList() {
+    splice(end(), other);
+  }
+  // the objects stay where they are; they are just on no list afterwards
+  ~IntrusiveList() { clear(); }
+
+  bool empty() const { return head.succ == &head; }
+  size_t size() const { return count; }
+
+  iterator begin() { return iterator{head.succ}; }
+  iterator end() { return iterator{&head}; }
+  const_iterator begin() const { return const_iterator{head.succ}; }
+  const_iterator end() const { return const_iterator{mutable_head()}; }
+
+  T &front() { return *begin(); }
+  T &back() { return *iterator{head.prev}; }
+
+  // puts x before pos, like insert(p, n) for Links; returns x's position
+  iterator insert(iterator pos, T &x) {
+    Hook *n = &hook_of(x), *p = pos.hook;
+    n->succ = p;
+    n->prev = p->prev;
+    p->prev->succ = n;
+    p->prev = n;
+    ++count;
+    return iterator{n};
+  }
+
+  void push_front(T &x) { insert(begin(), x); }
+  void push_back(T &x) { insert(end(), x); }
+
+  // takes the object at pos off the list; returns the position after it
+  iterator erase(iterator pos) {
+    Hook *h = pos.hook, *next = h->succ;
+    unlink(h);
+    --count;
+    return iterator{next};
+  }
+
+  void remove(T &x) { erase(iterator_to(x)); }
+  void pop_front() { erase(begin()); }
+  void pop_back() { erase(iterator{head.prev}); }
+
+  void clear() {
+    while (!empty())
+      pop_front();
+  }
+
+  // the position of an object that is on this list
+  iterator iterator_to(T &x) { return iterator{&hook_of(x)}; }
+
+  // moves all of other's objects in front of pos
+  void splice(iterator pos, IntrusiveList &other) {
+    if (other.empty() || &other == this)
+      return;
+    Hook *first = other.head.succ, *last = other.head.prev, *p = pos.hook;
+    other.head.prev = other.head.succ = &other.head;
+    first->prev = p->prev;
+    p->prev->succ = first;
+    last->succ = p;
+    p->prev = last;
+    count += other.count;
+    other.count = 0;
+  }
+
+  // moves the object at it (on other) in front of pos
+  void splice(iterator pos, IntrusiveList &other, iterator it) {
+    if (pos == it || pos.hook == it.hook->succ)
+      return;
+    T &x = *it;
+    other.erase(it);
+    insert(pos, x);
+  }
+
+private:
+  static T *owner(Hook *h) { return static_cast<T *>(h); }
+  static Hook &hook_of(T &x) { return static_cast<Hook &>(x); }
+
+  static void unlink(Hook *h) {
+    h->prev->succ = h->succ;
+    h->succ->prev = h->prev;
+    h->prev = h->succ = nullptr;
+  }
+
+  Hook *mutable_head() const { return const_cast<Hook *>(&head); }
+
+  Hook head; // the list is a ring through head, so there are no null checks
+  size_t count = 0;
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * Link: a doubly linked list of strings, and a pool that hands out Links
+ * from big chunks instead of one new per Link
+ */
+
+#include "connor.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+struct Link {
+  Link(const string &v, Link *p = nullptr, Link *s = nullptr)
+      : value{v}, prev{p}, succ{s} {}
+  string value;
+  Link *prev;
+  Link *succ;
+};
+
+// insert n before p; return n
+inline Link *insert(Link *p, Link *n) {
+  if (n == nullptr)
+    return p;
+  if (p == nullptr)
+    return n;
+  n->succ = p;
+  if (p->prev)
+    p->prev->succ = n;
+  n->prev = p->prev;
+  p->prev = n;
+  return n;
+}
+
+// take p out of its list; return its successor. p itself is not freed.
+inline Link *erase(Link *p) {
+  if (p == nullptr)
+    return nullptr;
+  if (p->succ)
+    p->succ->prev = p->prev;
+  if (p->prev)
+    p->prev->succ = p->succ;
+  return p->succ;
+}
+
+// owns the Links of a list. make() takes a slot from the free list or the
+// newest chunk, free() puts one back for the next make(), and whatever is
+// still alive when the pool goes away is destroyed with it.
+class LinkPool {
+public:
+  static constexpr size_t chunk_links = 1024;
+
+  LinkPool() = default;
+  LinkPool(const LinkPool &) = delete;
+  LinkPool &operator=(const LinkPool &) = delete;
+
+  ~LinkPool() {
+    if (live == 0)
+      return;
+    // every slot handed out and not on the free list is still a Link
+    vector<Slot *> freed;
+    for (Slot *s = free_list; s; s = s->next)
+      freed.push_back(s);
+    sort(freed.begin(), freed.end());
+    for (size_t c = 0; c < chunks.size(); ++c) {
+      size_t n = c + 1 == chunks.size() ? used : chunk_links;
+      for (size_t i = 0; i < n; ++i) {
+        Slot *s = &chunks[c][i];
+        if (!binary_search(freed.begin(), freed.end(), s))
+          s->link.~Link();
+      }
+    }
+  }
+
+  Link *make(const string &v, Link *p = nullptr, Link *s = nullptr) {
+    Slot *slot = free_list;
+    if (slot) {
+      free_list = slot->next;
+    } else {
+      if (chunks.empty() || used == chunk_links) {
+        chunks.push_back(make_unique<Slot[]>(chunk_links));
+        used = 0;
+      }
+      slot = &chunks.back()[used++];
+    }
+    Link *l = new (&slot->link) Link{v, p, s};
+    ++live;
+    return l;
+  }
+
+  // l must have come from this pool's make()
+  void free(Link *l) {
+    if (l == nullptr)
+      return;
+    l->~Link();
+    --live;
+    Slot *slot = reinterpret_cast<Slot *>(l);
+    slot->next = free_list;
+    free_list = slot;
+  }
+
+private:
+  // a Link while in use, a free list entry while not
+  union Slot {
+    Slot() {}
+    ~Slot() {}
+    Link link;
+    Slot *next;
+  };
+
+  vector<unique_ptr<Slot[]>> chunks;
+  size_t used = 0; // slots handed out from the newest chunk
+  Slot *free_list = nullptr;
+  size_t live = 0; // Links made and not yet freed
+};
@@ -0,0 +1,202 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * LinkArena: Links that live in one vector and point at each other by
+ * 32-bit index instead of by pointer. their strings live in one more vector
+ * of chars, so a node is 16 bytes next to Link's 48, and the whole arena can
+ * be copied, moved or saved to a file as two flat blocks of memory.
+ */
+
+#include "connor.h"
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+
+// a Link with indexes into a LinkArena in place of pointers
+struct CompactLink {
+  uint32_t prev;
+  uint32_t succ;
+  uint32_t text; // where the value starts in the arena's chars
+  uint32_t len;
+};
+
+class LinkArena {
+public:
+  using Index = uint32_t;
+  static constexpr Index none = numeric_limits<Index>::max(); // nullptr
+
+  LinkArena() = default;
+
+  Index make(string_view v, Index p = none, Index s = none) {
+    if (text.size() + v.size() > numeric_limits<uint32_t>::max())
+      throw runtime_error("LinkArena: more than 4GB of text");
+    CompactLink l{p, s, static_cast<uint32_t>(text.size()),
+                  static_cast<uint32_t>(v.size())};
+    text.insert(text.end(), v.begin(), v.end());
+    ++live;
+    if (free_list != none) {
+      Index i = free_list;
+      free_list = links[i].succ;
+      links[i] = l;
+      return i;
+    }
+    if (links.size() == none)
+      throw runtime_error("LinkArena: too many links");
+    links.push_back(l);
+    return static_cast<Index>(links.size() - 1);
+  }
+
+  // i's slot is reused by the next make(). its text stays until compact().
+  void free(Index i) {
+    if (i == none)
+      return;
+    links[i].succ = free_list;
+    free_list = i;
+    --live;
+  }
+
+  CompactLink &operator[](Index i) { return links[i]; }
+  const CompactLink &operator[](Index i) const { return links[i]; }
+  string_view value(Index i) const {
+    return {text.data() + links[i].text, links[i].len};
+  }
+
+  // insert n before p; return n
+  Index insert(Index p, Index n) {
+    if (n == none)
+      return p;
+    if (p == none)
+      return n;
+    CompactLink &pl = links[p], &nl = links[n];
+    nl.succ = p;
+    if (pl.prev != none)
+      links[pl.prev].succ = n;
+    nl.prev = pl.prev;
+    pl.prev = n;
+    return n;
+  }
+
+  // take p out of its list; return its successor. p itself is not freed.
+  Index erase(Index p) {
+    if (p == none)
+      return none;
+    CompactLink &pl = links[p];
+    if (pl.succ != none)
+      links[pl.succ].prev = pl.prev;
+    if (pl.prev != none)
+      links[pl.prev].succ = pl.succ;
+    return pl.succ;
+  }
+
+  size_t size() const { return live; }
+
+  // lays the list starting at head out again in order, links and text both,
+  // so walking it reads memory front to back. anything not on that list is
+  // dropped, and every index changes; returns the new head (which is 0).
+  Index compact(Index head) {
+    vector<CompactLink> new_links;
+    vector<char> new_text;
+    new_links.reserve(live);
+    for (Index i = head; i != none; i = links[i].succ) {
+      const CompactLink &l = links[i];
+      Index at = static_cast<Index>(new_links.size());
+      new_links.push_back({at == 0 ? none : at - 1, at + 1,
+                           static_cast<uint32_t>(new_text.size()), l.len});
+      new_text.insert(new_text.end(), text.begin() + l.text,
+                      text.begin() + l.text + l.len);
+    }
+    head = new_links.empty() ? none : 0;
+    if (head != none)
+      new_links.back().succ = none;
+    links = move(new_links);
+    text = move(new_text);
+    free_list = none;
+    live = links.size();
+    return head;
+  }
+
+  // the arena as raw bytes: a header, then the links and the text exactly
+  // as they sit in memory. load() only reads back what save() wrote on a
+  // machine with the same byte order.
+  void save(ostream &os) const {
+    uint64_t header[4] = {magic, links.size(), text.size(), free_list};
+    os.write(reinterpret_cast<const char *>(header), sizeof header);
+    os.write(reinterpret_cast<const char *>(links.data()),
+             static_cast<streamsize>(links.size() * sizeof(CompactLink)));
+    os.write(text.data(), static_cast<streamsize>(text.size()));
+  }
+
+  static LinkArena load(istream &is) {
+    uint64_t header[4];
+    if (!is.read(reinterpret_cast<char *>(header), sizeof header) ||
+        header[0] != magic)
+      throw runtime_error("LinkArena: not a saved arena");
+    if (header[1] > none || header[2] > numeric_limits<uint32_t>::max() ||
+        header[3] > none)
+      throw runtime_error("LinkArena: saved arena is damaged");
+    LinkArena a;
+    a.links.resize(header[1]);
+    a.text.resize(header[2]);
+    a.free_list = static_cast<Index>(header[3]);
+    is.read(reinterpret_cast<char *>(a.links.data()),
+            static_cast<streamsize>(a.links.size() * sizeof(CompactLink)));
+    is.read(a.text.data(), static_cast<streamsize>(a.text.size()));
+    if (!is)
+      throw runtime_error("LinkArena: saved arena is cut short");
+    a.live = a.links.size();
+    vector<bool> freed(a.links.size());
+    for (Index i = a.free_list; i != none; i = a.links[i].succ) {
+      if (i >= a.links.size() || freed[i])
+        throw runtime_error("LinkArena: saved arena is damaged");
+      freed[i] = true;
+      --a.live;
+    }
+    // every link's text has to be inside text, and every live link has to
+    // point at links that exist, without going round in a circle
+    for (const CompactLink &l : a.links)
+      if (uint64_t{l.text} + l.len > a.text.size())
+        throw runtime_error("LinkArena: saved arena is damaged");
+    for (Index i = 0; i < a.links.size(); ++i) {
+      const CompactLink &l = a.links[i];
+      if (!freed[i] && ((l.prev != none && l.prev >= a.links.size()) ||
+                        (l.succ != none && l.succ >= a.links.size())))
+        throw runtime_error("LinkArena: saved arena is damaged");
+    }
+    if (a.has_cycle(freed, &CompactLink::succ) ||
+        a.has_cycle(freed, &CompactLink::prev))
+      throw runtime_error("LinkArena: saved arena is damaged");
+    return a;
+  }
+
+private:
+  // whether following next from some live link comes back around. a walk
+  // stops at none or at a freed link, whose pointers mean nothing.
+  bool has_cycle(const vector<bool> &freed, Index CompactLink::*next) const {
+    enum : uint8_t { unseen, walking, done };
+    vector<uint8_t> state(links.size(), unseen);
+    for (Index start = 0; start < links.size(); ++start) {
+      Index i = start;
+      for (; i != none && !freed[i] && state[i] == unseen; i = links[i].*next)
+        state[i] = walking;
+      if (i != none && !freed[i] && state[i] == walking)
+        return true;
+      for (Index j = start; j != i; j = links[j].*next)
+        state[j] = done;
+    }
+    return false;
+  }
+
+  static constexpr uint64_t magic = 0x4c4e4b4152454e41ULL; // starts every save
+
+  vector<CompactLink> links;
+  vector<char> text;
+  Index free_list = none; // chained through succ
+  size_t live = 0;        // links made and not yet freed
+};
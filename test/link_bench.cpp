@@ -0,0 +1,547 @@
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * timings for the Link list code
+ * usage: link_bench [section] [number of links]
+ */
+
+#include "connor.h"
+#include "concurrent_queue.h"
+#include "intrusive_list.h"
+#include "link_arena.h"
+#include "link_sort.h"
+#include "link.h"
+#include "skip_list.h"
+#include "unrolled_list.h"
+#include <chrono>
+#include <cstdlib>
+#include <list>
+#include <mutex>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+
+template <typename F> double time_ms(F &&f) {
+  auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+// builds a list of n links, then a few rounds of erasing every other link
+// and putting a new one back in its place, then frees everything (unless
+// walk_to_free is false and the caller frees them some other way). make
+// and drop are how links are created and destroyed.
+template <typename Make, typename Drop>
+size_t churn(size_t n, Make &&make, Drop &&drop, bool walk_to_free = true) {
+  Link *head = nullptr;
+  for (size_t i = 0; i < n; ++i)
+    head = insert(head, make("link " + to_string(i)));
+
+  for (int round = 0; round < 5; ++round) {
+    Link *p = head;
+    while (p && p->succ) {
+      Link *gone = p->succ;
+      Link *next = erase(gone);
+      drop(gone);
+      if (next)
+        insert(next, make("new " + to_string(round)));
+      p = next;
+    }
+  }
+
+  size_t count = 0;
+  for (Link *p = head; p;) {
+    Link *next = p->succ;
+    if (walk_to_free)
+      drop(p);
+    p = next;
+    ++count;
+  }
+  return count;
+}
+
+void bench_pool(size_t n) {
+  cout << "=== new/delete vs LinkPool, " << n << " links ===\n";
+  size_t a = 0, b = 0;
+  double plain = time_ms([&] {
+    a = churn(
+        n, [](const string &v) { return new Link{v}; },
+        [](Link *l) { delete l; });
+  });
+  double pooled = time_ms([&] {
+    LinkPool pool;
+    b = churn(
+        n, [&](const string &v) { return pool.make(v); },
+        [&](Link *l) { pool.free(l); });
+  });
+  // or leave the last links to the pool, which frees them all at once
+  double at_once = time_ms([&] {
+    LinkPool pool;
+    churn(
+        n, [&](const string &v) { return pool.make(v); },
+        [&](Link *l) { pool.free(l); }, false);
+  });
+  cout << "  new/delete:                  " << plain << " ms\n";
+  cout << "  LinkPool:                    " << pooled << " ms"
+       << (a == b ? "" : " MISMATCH!") << '\n';
+  cout << "  LinkPool, freed all at once: " << at_once << " ms\n";
+}
+
+struct ByTitle {};
+struct OnLoan {};
+
+// a book that can be on the shelf list and the on-loan list at once
+struct Book : ListHook<ByTitle>, ListHook<OnLoan> {
+  explicit Book(size_t id) : id{id} {}
+  size_t id;
+};
+
+void bench_intrusive(size_t n) {
+  cout << "=== IntrusiveList vs list<Book *>, " << n
+       << " books on two lists ===\n";
+  vector<Book> books;
+  books.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    books.emplace_back(i);
+
+  // put every book on the shelf and every third on loan, take every fifth
+  // off both, then walk both lists
+  size_t a = 0, b = 0;
+  double with_nodes = time_ms([&] {
+    list<Book *> shelf, loans;
+    vector<list<Book *>::iterator> on_shelf(n), on_loan(n);
+    for (Book &x : books) {
+      on_shelf[x.id] = shelf.insert(shelf.end(), &x);
+      if (x.id % 3 == 0)
+        on_loan[x.id] = loans.insert(loans.end(), &x);
+    }
+    for (size_t i = 0; i < n; i += 5) {
+      shelf.erase(on_shelf[i]);
+      if (i % 3 == 0)
+        loans.erase(on_loan[i]);
+    }
+    for (Book *x : shelf)
+      a += x->id;
+    for (Book *x : loans)
+      a += x->id;
+  });
+  double intrusive = time_ms([&] {
+    IntrusiveList<Book, ByTitle> shelf;
+    IntrusiveList<Book, OnLoan> loans;
+    for (Book &x : books) {
+      shelf.push_back(x);
+      if (x.id % 3 == 0)
+        loans.push_back(x);
+    }
+    for (size_t i = 0; i < n; i += 5) {
+      shelf.remove(books[i]);
+      if (i % 3 == 0)
+        loans.remove(books[i]);
+    }
+    for (Book &x : shelf)
+      b += x.id;
+    for (Book &x : loans)
+      b += x.id;
+  });
+  cout << "  list<Book *>, node per membership: " << with_nodes << " ms\n";
+  cout << "  IntrusiveList, hooks in Book:      " << intrusive << " ms"
+       << (a == b ? "" : " MISMATCH!") << '\n';
+}
+
+void bench_unrolled(size_t n) {
+  cout << "=== vector vs Link vs UnrolledList, " << n << " values ===\n";
+  vector<string> vec;
+  for (size_t i = 0; i < n; ++i)
+    vec.push_back("v" + to_string(i));
+
+  // Links in a list that has seen a lot of inserts: next to each other in
+  // the list, nowhere near each other in memory
+  LinkPool pool;
+  vector<Link *> links;
+  for (const string &v : vec)
+    links.push_back(pool.make(v));
+  mt19937_64 rng(8);
+  shuffle(links.begin(), links.end(), rng);
+  Link *head = nullptr;
+  for (Link *l : links)
+    head = insert(head, l);
+
+  UnrolledList<string> unrolled;
+  for (const string &v : vec)
+    unrolled.push_back(v);
+
+  size_t a = 0, b = 0, c = 0;
+  double walk_vec = time_ms([&] {
+    for (const string &s : vec)
+      a += s.size();
+  });
+  double walk_links = time_ms([&] {
+    for (Link *p = head; p; p = p->succ)
+      b += p->value.size();
+  });
+  double walk_unrolled = time_ms([&] {
+    for (const string &s : unrolled)
+      c += s.size();
+  });
+  cout << "  walk: vector " << walk_vec << " ms, Link " << walk_links
+       << " ms, UnrolledList " << walk_unrolled << " ms"
+       << (a == b && b == c ? "" : " MISMATCH!") << '\n';
+
+  // inserts at a cursor that moves a little way forward each time. every
+  // vector insert shifts the rest of the vector, so it only does 1% of them.
+  const size_t inserts = 100000;
+  vector<size_t> steps(inserts);
+  for (size_t &s : steps)
+    s = rng() % 32;
+  double ins_vec = time_ms([&] {
+    size_t pos = 0;
+    for (size_t j = 0; j < inserts / 100; ++j) {
+      pos += steps[j];
+      if (pos >= vec.size())
+        pos = 0;
+      vec.insert(vec.begin() + static_cast<ptrdiff_t>(pos), "new");
+    }
+  });
+  double ins_links = time_ms([&] {
+    Link *p = head;
+    for (size_t s : steps) {
+      for (size_t k = 0; k < s && p; ++k)
+        p = p->succ;
+      if (!p)
+        p = head;
+      Link *n = insert(p, pool.make("new"));
+      if (p == head)
+        head = n;
+      p = n;
+    }
+  });
+  double ins_unrolled = time_ms([&] {
+    auto it = unrolled.begin();
+    for (size_t s : steps) {
+      for (size_t k = 0; k < s && it != unrolled.end(); ++k)
+        ++it;
+      if (it == unrolled.end())
+        it = unrolled.begin();
+      it = unrolled.insert(it, "new");
+    }
+  });
+  cout << "  microseconds per insert: vector "
+       << ins_vec * 1000 / (inserts / 100) << ", Link "
+       << ins_links * 1000 / inserts << ", UnrolledList "
+       << ins_unrolled * 1000 / inserts << '\n';
+}
+
+// list<string> behind one mutex, the usual way to share a list
+class LockedList {
+public:
+  struct Handle {};
+  Handle handle() { return {}; }
+  void push(Handle &, string v) {
+    lock_guard<mutex> lk{m};
+    values.push_back(move(v));
+  }
+  bool pop(Handle &, string &out) {
+    lock_guard<mutex> lk{m};
+    if (values.empty())
+      return false;
+    out = move(values.front());
+    values.pop_front();
+    return true;
+  }
+
+private:
+  mutex m;
+  list<string> values;
+};
+
+// producers push "p:i" for i = 0..per-1 while consumers pop. checks that
+// every value comes out exactly once and that each producer's values come
+// out in the order it pushed them. returns false if anything is off.
+template <typename Queue>
+bool produce_consume(Queue &q, unsigned producers, unsigned consumers,
+                     size_t per) {
+  atomic<size_t> popped{0}, sum{0};
+  atomic<bool> out_of_order{false};
+  const size_t total = producers * per;
+  vector<thread> threads;
+  for (unsigned p = 0; p < producers; ++p)
+    threads.emplace_back([&, p] {
+      auto h = q.handle();
+      for (size_t i = 0; i < per; ++i)
+        q.push(h, to_string(p) + ':' + to_string(i));
+    });
+  for (unsigned c = 0; c < consumers; ++c)
+    threads.emplace_back([&] {
+      auto h = q.handle();
+      vector<long> last(producers, -1);
+      string v;
+      size_t local = 0;
+      while (popped.load(memory_order_relaxed) < total) {
+        if (!q.pop(h, v))
+          continue;
+        size_t colon = v.find(':');
+        size_t p = stoul(v.substr(0, colon));
+        long i = stol(v.substr(colon + 1));
+        if (i <= last[p])
+          out_of_order = true;
+        last[p] = i;
+        local += static_cast<size_t>(i);
+        popped.fetch_add(1, memory_order_relaxed);
+      }
+      sum += local;
+    });
+  for (thread &t : threads)
+    t.join();
+  return popped == total && sum == producers * (per * (per - 1) / 2) &&
+         !out_of_order;
+}
+
+void bench_concurrent(size_t n) {
+  unsigned side = clamp(thread::hardware_concurrency() / 2, 2u, 8u);
+  cout << "=== ConcurrentQueue vs locked list<string>, " << n << " values, "
+       << side << " producers, " << side << " consumers ===\n";
+  size_t per = n / side;
+  bool ok_lock = true, ok_free = true;
+  double locked = time_ms([&] {
+    LockedList q;
+    ok_lock = produce_consume(q, side, side, per);
+  });
+  double lock_free = time_ms([&] {
+    ConcurrentQueue<string> q;
+    ok_free = produce_consume(q, side, side, per);
+  });
+  cout << "  mutex + list<string>: " << locked << " ms"
+       << (ok_lock ? "" : " LOST OR REORDERED VALUES!") << '\n';
+  cout << "  ConcurrentQueue:      " << lock_free << " ms"
+       << (ok_free ? "" : " LOST OR REORDERED VALUES!") << '\n';
+}
+
+void bench_skiplist(size_t n) {
+  cout << "=== Link vs SkipList vs set, " << n << " values ===\n";
+  mt19937_64 rng(12);
+  vector<string> values(n);
+  for (string &v : values)
+    v = "book " + to_string(rng() % (4 * n));
+  vector<string> queries(n);
+  for (string &q : queries)
+    q = "book " + to_string(rng() % (4 * n));
+
+  // a Link chain can only be searched from the front
+  LinkPool pool;
+  Link *head = nullptr;
+  for (const string &v : values)
+    head = insert(head, pool.make(v));
+  const size_t link_queries = 100;
+  size_t link_hits = 0;
+  double link_find = time_ms([&] {
+    for (size_t i = 0; i < link_queries; ++i) {
+      Link *p = head;
+      while (p && p->value != queries[i])
+        p = p->succ;
+      link_hits += p != nullptr;
+    }
+  });
+
+  SkipList<string> skip;
+  set<string> tree;
+  double skip_insert = time_ms([&] {
+    for (const string &v : values)
+      skip.insert(v);
+  });
+  double set_insert = time_ms([&] {
+    for (const string &v : values)
+      tree.insert(v);
+  });
+  size_t skip_hits = 0, set_hits = 0;
+  double skip_find = time_ms([&] {
+    for (const string &q : queries)
+      skip_hits += skip.contains(q);
+  });
+  double set_find = time_ms([&] {
+    for (const string &q : queries)
+      set_hits += tree.count(q);
+  });
+  size_t set_link_hits = 0;
+  for (size_t i = 0; i < link_queries; ++i)
+    set_link_hits += tree.count(queries[i]);
+  double skip_erase = time_ms([&] {
+    for (size_t i = 0; i < n; i += 2)
+      skip.erase(values[i]);
+  });
+  double set_erase = time_ms([&] {
+    for (size_t i = 0; i < n; i += 2)
+      tree.erase(values[i]);
+  });
+  size_t a = 0, b = 0;
+  double skip_walk = time_ms([&] {
+    for (const string &v : skip)
+      a += v.size();
+  });
+  double set_walk = time_ms([&] {
+    for (const string &v : tree)
+      b += v.size();
+  });
+  bool same = skip_hits == set_hits && link_hits == set_link_hits && a == b &&
+              equal(skip.begin(), skip.end(), tree.begin(), tree.end());
+
+  cout << "  microseconds per lookup: Link " << link_find * 1000 / link_queries
+       << ", SkipList " << skip_find * 1000 / n << ", set "
+       << set_find * 1000 / n << '\n';
+  cout << "  insert all: SkipList " << skip_insert << " ms, set " << set_insert
+       << " ms\n";
+  cout << "  erase half: SkipList " << skip_erase << " ms, set " << set_erase
+       << " ms\n";
+  cout << "  walk: SkipList " << skip_walk << " ms, set " << set_walk << " ms"
+       << (same ? "" : " MISMATCH!") << '\n';
+}
+
+void bench_arena(size_t n) {
+  cout << "=== Link vs LinkArena, " << n << " links ===\n";
+  cout << "  bytes per node: Link " << sizeof(Link) << ", CompactLink "
+       << sizeof(CompactLink) << " (+ the value's chars)\n";
+
+  // both lists link their nodes in a shuffled order, like a list that has
+  // seen a lot of inserts
+  vector<size_t> order(n);
+  for (size_t i = 0; i < n; ++i)
+    order[i] = i;
+  mt19937_64 rng(9);
+  shuffle(order.begin(), order.end(), rng);
+
+  LinkPool pool;
+  vector<Link *> links;
+  LinkArena arena;
+  vector<LinkArena::Index> ids;
+  for (size_t i = 0; i < n; ++i) {
+    string v = "link " + to_string(i);
+    links.push_back(pool.make(v));
+    ids.push_back(arena.make(v));
+  }
+  Link *head = nullptr;
+  LinkArena::Index first = LinkArena::none;
+  for (size_t i : order) {
+    head = insert(head, links[i]);
+    first = arena.insert(first, ids[i]);
+  }
+
+  size_t a = 0, b = 0, c = 0, d = 0;
+  double walk_links = time_ms([&] {
+    for (Link *p = head; p; p = p->succ)
+      a += p->value.size();
+  });
+  double walk_arena = time_ms([&] {
+    for (LinkArena::Index i = first; i != LinkArena::none; i = arena[i].succ)
+      b += arena.value(i).size();
+  });
+  double compact = time_ms([&] { first = arena.compact(first); });
+  double walk_compact = time_ms([&] {
+    for (LinkArena::Index i = first; i != LinkArena::none; i = arena[i].succ)
+      c += arena.value(i).size();
+  });
+
+  stringstream file;
+  double save = time_ms([&] { arena.save(file); });
+  LinkArena loaded;
+  double load = time_ms([&] { loaded = LinkArena::load(file); });
+  bool same = loaded.size() == n;
+  LinkArena::Index j = first;
+  for (Link *p = head; p && same; p = p->succ, j = loaded[j].succ) {
+    same = j != LinkArena::none && loaded.value(j) == p->value;
+    d += p->value.size();
+  }
+  same = same && j == LinkArena::none && a == b && b == c && c == d;
+
+  cout << "  walk: Link " << walk_links << " ms, LinkArena " << walk_arena
+       << " ms, LinkArena after compact() " << walk_compact << " ms\n";
+  cout << "  compact " << compact << " ms, save " << save << " ms, load "
+       << load << " ms (" << file.str().size() << " bytes)"
+       << (same ? "" : " MISMATCH!") << '\n';
+}
+
+// true if the list from head holds exactly want, in order, with every prev
+// pointing back at the link before it
+bool sorted_as(Link *head, const vector<string> &want) {
+  size_t i = 0;
+  for (Link *p = head, *before = nullptr; p; before = p, p = p->succ, ++i)
+    if (i == want.size() || p->value != want[i] || p->prev != before)
+      return false;
+  return i == want.size();
+}
+
+void bench_sort(size_t n) {
+  cout << "=== sorting a Link list, " << n << " links ===\n";
+  vector<string> values;
+  mt19937_64 rng(10);
+  for (size_t i = 0; i < n; ++i)
+    values.push_back("v" + to_string(rng() % (n + 1)));
+  vector<string> want = values;
+  stable_sort(want.begin(), want.end());
+
+  LinkPool pool;
+  auto build = [&] {
+    Link *head = nullptr;
+    for (auto v = values.rbegin(); v != values.rend(); ++v)
+      head = insert(head, pool.make(*v));
+    return head;
+  };
+
+  // what there was before: copy the values out, sort them, copy them back
+  Link *copied = build();
+  double by_vector = time_ms([&] {
+    vector<string> tmp;
+    for (Link *p = copied; p; p = p->succ)
+      tmp.push_back(move(p->value));
+    sort(tmp.begin(), tmp.end());
+    size_t i = 0;
+    for (Link *p = copied; p; p = p->succ)
+      p->value = move(tmp[i++]);
+  });
+  bool same = sorted_as(copied, want);
+
+  Link *in_place = build();
+  double serial = time_ms([&] { in_place = sort_list(in_place); });
+  same = same && sorted_as(in_place, want);
+
+  const unsigned threads = 4;
+  Link *parallel = build();
+  double par = time_ms([&] {
+    parallel = parallel_sort_list(parallel, threads);
+  });
+  same = same && sorted_as(parallel, want);
+
+  list<string> std_list(values.begin(), values.end());
+  double by_list = time_ms([&] { std_list.sort(); });
+  same = same && equal(std_list.begin(), std_list.end(), want.begin());
+
+  cout << "  copy to vector and back " << by_vector << " ms, sort_list "
+       << serial << " ms, parallel_sort_list (" << threads << " threads, "
+       << thread::hardware_concurrency() << " cpus) " << par
+       << " ms, list::sort " << by_list << " ms"
+       << (same ? "" : " MISMATCH!") << '\n';
+}
+
+int main(int argc, char *argv[]) {
+  string section = argc > 1 ? argv[1] : "all";
+  size_t n = argc > 2 ? stoul(argv[2]) : 1000000;
+
+  if (section == "all" || section == "pool")
+    bench_pool(n);
+  if (section == "all" || section == "intrusive")
+    bench_intrusive(n);
+  if (section == "all" || section == "unrolled")
+    bench_unrolled(n);
+  if (section == "all" || section == "concurrent")
+    bench_concurrent(n);
+  if (section == "all" || section == "skiplist")
+    bench_skiplist(n);
+  if (section == "all" || section == "arena")
+    bench_arena(n);
+  if (section == "all" || section == "sort")
+    bench_sort(n);
+
+  return 0;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * sorting a Link list where it stands: a bottom-up merge sort that only
+ * relinks succ and prev, with no recursion and nothing allocated, and a
+ * version that sorts pieces of the list on several threads and then merges
+ * them.
+ */
+
+#include "connor.h"
+#include "link.h"
+#include <cstddef>
+#include <functional>
+#include <thread>
+
+namespace link_sort {
+
+// merges two sorted succ chains ending in nullptr. ties keep a's links
+// first, so the sort is stable. prev is left for the caller to fix up.
+template <typename Compare> Link *merge(Link *a, Link *b, Compare &comp) {
+  Link *head = nullptr;
+  Link **tail = &head;
+  while (a && b) {
+    if (comp(b->value, a->value)) {
+      *tail = b;
+      b = b->succ;
+    } else {
+      *tail = a;
+      a = a->succ;
+    }
+    tail = &(*tail)->succ;
+  }
+  *tail = a ? a : b;
+  return head;
+}
+
+// sorts the succ chain from head. runs[k] holds a sorted run of 2^k links
+// or nothing; each link is merged in like carrying in binary addition,
+// so runs only ever merge with runs their own size.
+template <typename Compare> Link *sort_chain(Link *head, Compare &comp) {
+  Link *runs[64] = {};
+  int used = 0;
+  while (head) {
+    Link *carry = head;
+    head = head->succ;
+    carry->succ = nullptr;
+    int k = 0;
+    for (; runs[k]; ++k) {
+      carry = merge(runs[k], carry, comp);
+      runs[k] = nullptr;
+    }
+    runs[k] = carry;
+    used = max(used, k + 1);
+  }
+  Link *sorted = nullptr;
+  for (int k = 0; k < used; ++k)
+    if (runs[k])
+      sorted = merge(runs[k], sorted, comp); // runs[k] came first
+  return sorted;
+}
+
+// points every prev back at the link before it
+inline void fix_prev(Link *head) {
+  Link *before = nullptr;
+  for (Link *p = head; p; p = p->succ) {
+    p->prev = before;
+    before = p;
+  }
+}
+
+} // namespace link_sort
+
+// sorts the list starting at head (which must be its first link) by value;
+// returns the new first link
+template <typename Compare = less<>>
+Link *sort_list(Link *head, Compare comp = {}) {
+  head = link_sort::sort_chain(head, comp);
+  link_sort::fix_prev(head);
+  return head;
+}
+
+// sort_list on up to threads threads: the list is cut into that many
+// pieces, each piece is sorted on its own thread, and then pairs of pieces
+// are merged, also in parallel, until one is left. comp is called from
+// several threads at once. extra memory is a few pointers per thread.
+template <typename Compare = less<>>
+Link *parallel_sort_list(Link *head, unsigned threads = 0,
+                         Compare comp = {}) {
+  if (threads == 0)
+    threads = max(1u, thread::hardware_concurrency());
+  size_t n = 0;
+  for (Link *p = head; p; p = p->succ)
+    ++n;
+  if (threads == 1 || n < 2 * threads)
+    return sort_list(head, comp);
+
+  vector<Link *> pieces;
+  for (unsigned t = 0; t < threads; ++t) {
+    pieces.push_back(head);
+    size_t len = n / threads + (t < n % threads ? 1 : 0);
+    Link *last = head;
+    for (size_t i = 1; i < len; ++i)
+      last = last->succ;
+    head = last->succ;
+    last->succ = nullptr;
+  }
+
+  vector<thread> workers;
+  auto join_all = [&] {
+    for (thread &w : workers)
+      w.join();
+    workers.clear();
+  };
+  for (Link *&piece : pieces)
+    workers.emplace_back(
+        [&piece, &comp] { piece = link_sort::sort_chain(piece, comp); });
+  join_all();
+  // pieces[i] is from earlier in the list than pieces[i + step], which
+  // keeps ties in order
+  for (size_t step = 1; step < pieces.size(); step *= 2) {
+    for (size_t i = 0; i + step < pieces.size(); i += 2 * step)
+      workers.emplace_back([&pieces, &comp, i, step] {
+        pieces[i] = link_sort::merge(pieces[i], pieces[i + step], comp);
+      });
+    join_all();
+  }
+
+  link_sort::fix_prev(pieces[0]);
+  return pieces[0];
+}
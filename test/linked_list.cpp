@@ -1,34 +1,16 @@
 
 #include "connor.h"
-
-struct Link {
-  Link(const string &v, Link *p = nullptr, Link *s = nullptr)
-      : value{v}, prev{p}, succ{s} {}
-  string value;
-  Link *prev;
-  Link *succ;
-};
-Link *insert(Link *p, Link *n) {
-  if (n == nullptr)
-    return p;
-  if (p == nullptr)
-    return n;
-  n->succ = p;
-  if (p->prev)
-    p->prev->succ = n;
-  n->prev = p->prev;
-  p->prev = n;
-  return n;
-}
+#include "link.h"
 
 int main() {
-  Link *norse_gods = new Link{"Thor"};
-  string norse_value = *norse_gods;
+  LinkPool pool; // frees every Link when main returns
+  Link *norse_gods = pool.make("Thor");
+  string norse_value = norse_gods->value;
   cout << norse_value;
 
-  norse_gods = insert(norse_gods, new Link{"Odin"});
+  norse_gods = insert(norse_gods, pool.make("Odin"));
 
-  norse_gods = insert(norse_gods, new Link{"Freja"});
+  norse_gods = insert(norse_gods, pool.make("Freja"));
 
   return 0;
 }
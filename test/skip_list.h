@@ -0,0 +1,270 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * SkipList: a sorted Link chain with express lanes. each node gets a
+ * random height and a tower of succ pointers that skip ahead, so finding,
+ * adding or removing a value takes O(log n) steps on average. walking it
+ * in order just follows the bottom succ pointers, like a Link list.
+ */
+
+#include "connor.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+template <typename T = string, typename Compare = less<>> class SkipList {
+public:
+  static constexpr int max_height = 32; // plenty for 2^31 values
+
+private:
+  // a node is followed in memory by its tower: height succ pointers, the
+  // bottom one first
+  struct Node {
+    template <typename V>
+    Node(V &&v, int height) : value{std::forward<V>(v)}, height{height} {
+      for (int level = 0; level < height; ++level)
+        construct_at(tower() + level, nullptr);
+    }
+    Node **tower() { return reinterpret_cast<Node **>(this + 1); }
+    Node *const *tower() const {
+      return reinterpret_cast<Node *const *>(this + 1);
+    }
+    T value;
+    Node *prev = nullptr; // bottom level only, for --
+    int height;
+  };
+
+  // a node and its tower, rounded up so the next node is aligned too
+  static size_t node_bytes(int height) {
+    size_t b = sizeof(Node) + static_cast<size_t>(height) * sizeof(Node *);
+    return (b + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+  }
+
+  // nodes and their towers are carved one after another out of big chunks,
+  // so nodes made together sit together. an erased node's space goes on a
+  // free list for its height.
+  class Pool {
+  public:
+    static constexpr size_t chunk_bytes = 64 * 1024;
+
+    void *get(int height) {
+      if (void *p = free[height]) {
+        free[height] = *static_cast<void **>(p);
+        return p;
+      }
+      size_t bytes = node_bytes(height);
+      if (chunks.empty() || used + bytes > chunk_bytes) {
+        chunks.push_back(make_unique<Chunk>());
+        used = 0;
+      }
+      void *p = chunks.back()->bytes + used;
+      used += bytes;
+      return p;
+    }
+
+    void put(void *p, int height) {
+      *static_cast<void **>(p) = free[height];
+      free[height] = p;
+    }
+
+  private:
+    struct Chunk {
+      alignas(Node) unsigned char bytes[chunk_bytes];
+    };
+
+    vector<unique_ptr<Chunk>> chunks;
+    size_t used = 0;
+    void *free[max_height + 1] = {};
+  };
+
+public:
+  class const_iterator {
+  public:
+    using iterator_category = bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    const_iterator() = default;
+
+    reference operator*() const { return node->value; }
+    pointer operator->() const { return &node->value; }
+
+    const_iterator &operator++() {
+      node = node->tower()[0];
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator old = *this;
+      ++*this;
+      return old;
+    }
+    const_iterator &operator--() {
+      node = node ? node->prev : list->last;
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    bool operator==(const const_iterator &o) const { return node == o.node; }
+
+  private:
+    friend class SkipList;
+    const_iterator(const Node *node, const SkipList *list)
+        : node{node}, list{list} {}
+    const Node *node = nullptr;
+    const SkipList *list = nullptr;
+  };
+  using iterator = const_iterator; // values can't change in place, like set
+
+  SkipList() = default;
+  SkipList(const SkipList &other) {
+    for (const T &v : other)
+      insert(v);
+  }
+  SkipList &operator=(const SkipList &other) {
+    if (this != &other) {
+      clear();
+      for (const T &v : other)
+        insert(v);
+    }
+    return *this;
+  }
+  ~SkipList() { clear(); }
+
+  size_t size() const { return n; }
+  bool empty() const { return n == 0; }
+
+  const_iterator begin() const { return {heads[0], this}; }
+  const_iterator end() const { return {nullptr, this}; }
+
+  // first value not less than key
+  template <typename K> const_iterator lower_bound(const K &key) const {
+    Node *const *links = heads;
+    const Node *stop = nullptr; // already known to be >= key
+    for (int level = height - 1; level >= 0; --level) {
+      while (links[level] != stop && comp(links[level]->value, key))
+        links = links[level]->tower();
+      stop = links[level];
+    }
+    return {height > 0 ? links[0] : nullptr, this};
+  }
+
+  template <typename K> const_iterator find(const K &key) const {
+    const_iterator it = lower_bound(key);
+    return it != end() && !comp(key, *it) ? it : end();
+  }
+
+  template <typename K> bool contains(const K &key) const {
+    return find(key) != end();
+  }
+
+  // adds v unless an equal value is already there
+  template <typename V> pair<const_iterator, bool> insert(V &&v) {
+    Node **before[max_height];
+    Node *pred;
+    Node *found = search(v, before, pred);
+    if (found && !comp(v, found->value))
+      return {{found, this}, false};
+
+    int h = random_height();
+    for (; height < h; ++height)
+      before[height] = &heads[height];
+    Node *node = new (pool.get(h)) Node{std::forward<V>(v), h};
+    for (int level = 0; level < h; ++level) {
+      node->tower()[level] = *before[level];
+      *before[level] = node;
+    }
+    // the bottom level also links backwards
+    node->prev = pred;
+    (node->tower()[0] ? node->tower()[0]->prev : last) = node;
+    ++n;
+    return {{node, this}, true};
+  }
+
+  // number of values removed (0 or 1)
+  template <typename K> size_t erase(const K &key) {
+    Node **before[max_height];
+    Node *pred;
+    Node *node = search(key, before, pred);
+    if (!node || comp(key, node->value))
+      return 0;
+    for (int level = 0; level < node->height; ++level)
+      *before[level] = node->tower()[level];
+    (node->tower()[0] ? node->tower()[0]->prev : last) = node->prev;
+    while (height > 0 && !heads[height - 1])
+      --height;
+    destroy(node);
+    --n;
+    return 1;
+  }
+
+  void clear() {
+    for (Node *p = heads[0]; p;) {
+      Node *next = p->tower()[0];
+      destroy(p);
+      p = next;
+    }
+    fill(heads, heads + max_height, nullptr);
+    last = nullptr;
+    height = 0;
+    n = 0;
+  }
+
+private:
+  // the first node not less than key, with before[level] set to the link
+  // at each level that points at or past it (where a new node would go)
+  // and pred to the last node before it (null if there is none)
+  template <typename K>
+  Node *search(const K &key, Node **before[], Node *&pred) {
+    Node **links = heads;
+    Node *stop = nullptr; // already known to be >= key
+    pred = nullptr;
+    for (int level = height - 1; level >= 0; --level) {
+      while (links[level] != stop && comp(links[level]->value, key)) {
+        pred = links[level];
+        links = pred->tower();
+      }
+      before[level] = &links[level];
+      stop = links[level];
+    }
+    return height > 0 ? *before[0] : nullptr;
+  }
+
+  // height h with chance 2^-h: one random bit per extra level. (a 1/4
+  // chance per level makes shorter towers but more steps per level, and
+  // measured slower here)
+  int random_height() {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return 1 + countr_zero(rng | (uint64_t{1} << (max_height - 1)));
+  }
+
+  void destroy(Node *node) {
+    int h = node->height;
+    node->~Node();
+    pool.put(node, h);
+  }
+
+  Node *heads[max_height] = {}; // the links out of the front, per level
+  Node *last = nullptr;         // for -- from end()
+  int height = 0;               // levels in use
+  size_t n = 0;
+  uint64_t rng = 0x9e3779b97f4a7c15ULL;
+  Pool pool;
+  [[no_unique_address]] Compare comp;
+};
@@ -0,0 +1,230 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * UnrolledList: a doubly linked list like Link, but each node holds a small
+ * array of values, so a walk takes one cache miss per node instead of one
+ * per value. full nodes split in two and nodes under half full take values
+ * from or merge with the next one.
+ */
+
+#include "connor.h"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+template <typename T = string, size_t NodeBytes = 512> class UnrolledList {
+  // values per node: whatever fits in NodeBytes next to the links
+  static constexpr size_t cap =
+      max<size_t>(4, (NodeBytes - 3 * sizeof(void *)) / sizeof(T));
+
+  struct Node {
+    Node *prev = nullptr;
+    Node *succ = nullptr;
+    size_t count = 0;
+    T items[cap];
+  };
+
+public:
+  template <bool Const> class Iterator {
+  public:
+    using iterator_category = bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = conditional_t<Const, const T *, T *>;
+    using reference = conditional_t<Const, const T &, T &>;
+
+    Iterator() = default;
+    template <bool C = Const, typename = enable_if_t<C>>
+    Iterator(const Iterator<false> &other)
+        : node{other.node}, i{other.i}, list{other.list} {}
+
+    reference operator*() const { return node->items[i]; }
+    pointer operator->() const { return &node->items[i]; }
+
+    Iterator &operator++() {
+      if (++i == node->count) {
+        node = node->succ;
+        i = 0;
+      }
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator old = *this;
+      ++*this;
+      return old;
+    }
+    Iterator &operator--() {
+      if (!node) {
+        node = list->tail;
+        i = node->count - 1;
+      } else if (i == 0) {
+        node = node->prev;
+        i = node->count - 1;
+      } else {
+        --i;
+      }
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    bool operator==(const Iterator &o) const {
+      return node == o.node && i == o.i;
+    }
+
+  private:
+    friend class UnrolledList;
+    friend class Iterator<!Const>;
+    Iterator(Node *node, size_t i, const UnrolledList *list)
+        : node{node}, i{i}, list{list} {}
+
+    Node *node = nullptr;
+    size_t i = 0;
+    const UnrolledList *list = nullptr;
+  };
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  UnrolledList() = default;
+  UnrolledList(initializer_list<T> values) {
+    for (const T &v : values)
+      push_back(v);
+  }
+  UnrolledList(const UnrolledList &other) {
+    for (const T &v : other)
+      push_back(v);
+  }
+  UnrolledList(UnrolledList &&other) noexcept { swap(other); }
+  UnrolledList &operator=(UnrolledList other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~UnrolledList() { clear(); }
+
+  void swap(UnrolledList &other) noexcept {
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    std::swap(n, other.n);
+  }
+
+  size_t size() const { return n; }
+  bool empty() const { return n == 0; }
+
+  iterator begin() { return {head, 0, this}; }
+  iterator end() { return {nullptr, 0, this}; }
+  const_iterator begin() const { return {head, 0, this}; }
+  const_iterator end() const { return {nullptr, 0, this}; }
+
+  T &front() { return head->items[0]; }
+  T &back() { return tail->items[tail->count - 1]; }
+
+  // puts v before pos, like insert(p, n) for Links; returns v's position
+  iterator insert(iterator pos, const T &v) {
+    Node *nd = pos.node;
+    size_t i = pos.i;
+    if (!nd) {
+      if (!tail || tail->count == cap)
+        link_after(tail, new Node);
+      nd = tail;
+      i = nd->count;
+    } else if (i == 0 && nd->prev && nd->prev->count < cap) {
+      // room at the end of the node before: no shifting needed
+      nd = nd->prev;
+      i = nd->count;
+    }
+
+    if (nd->count == cap) {
+      Node *right = new Node;
+      link_after(nd, right);
+      size_t keep = cap / 2;
+      move(nd->items + keep, nd->items + cap, right->items);
+      right->count = cap - keep;
+      nd->count = keep;
+      if (i > keep) {
+        nd = right;
+        i -= keep;
+      }
+    }
+
+    move_backward(nd->items + i, nd->items + nd->count,
+                  nd->items + nd->count + 1);
+    nd->items[i] = v;
+    ++nd->count;
+    ++n;
+    return {nd, i, this};
+  }
+
+  void push_back(const T &v) { insert(end(), v); }
+  void push_front(const T &v) { insert(begin(), v); }
+
+  // removes the value at pos; returns the position of the one after it
+  iterator erase(iterator pos) {
+    Node *nd = pos.node;
+    size_t i = pos.i;
+    move(nd->items + i + 1, nd->items + nd->count, nd->items + i);
+    nd->items[--nd->count] = T{}; // let go of what the moved-from slot held
+    --n;
+
+    if (nd->count == 0) {
+      Node *next = nd->succ;
+      unlink(nd);
+      return {next, 0, this};
+    }
+    if (nd->count < cap / 2 && nd->succ) {
+      Node *s = nd->succ;
+      // merge when both fit in one node, otherwise even the two out
+      size_t take = nd->count + s->count <= cap ? s->count
+                                                : (s->count - nd->count) / 2;
+      move(s->items, s->items + take, nd->items + nd->count);
+      move(s->items + take, s->items + s->count, s->items);
+      for (size_t k = s->count - take; k < s->count; ++k)
+        s->items[k] = T{};
+      nd->count += take;
+      s->count -= take;
+      if (s->count == 0)
+        unlink(s);
+    }
+    if (i == nd->count)
+      return {nd->succ, 0, this};
+    return {nd, i, this};
+  }
+
+  void clear() {
+    while (head) {
+      Node *next = head->succ;
+      delete head;
+      head = next;
+    }
+    tail = nullptr;
+    n = 0;
+  }
+
+private:
+  // node goes after at, or first if at is null
+  void link_after(Node *at, Node *node) {
+    node->prev = at;
+    node->succ = at ? at->succ : head;
+    (node->succ ? node->succ->prev : tail) = node;
+    (at ? at->succ : head) = node;
+  }
+
+  void unlink(Node *node) {
+    (node->prev ? node->prev->succ : head) = node->succ;
+    (node->succ ? node->succ->prev : tail) = node->prev;
+    delete node;
+  }
+
+  Node *head = nullptr;
+  Node *tail = nullptr;
+  size_t n = 0;
+};
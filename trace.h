@@ -0,0 +1,313 @@
+#pragma once
+
+/*
+ * connor crist
+ * intro to CS II
+ * 2026-10-19
+ * David Stafford
+ * tracing for code that runs too often to print from. a TRACE line is
+ * checked against the level and categories picked at compile time; when it
+ * is off it compiles to nothing. when it is on, it copies a 64-byte record
+ * (time, format, arguments) into a ring buffer that only its own thread
+ * writes, and a background thread turns the records into text later.
+ *
+ *   TRACE(trace::detail, trace::special_members, "copied {} ({} bytes)",
+ *         name, size);
+ *
+ * build with -DTRACE_LEVEL=1 (info) or 2 (detail) to turn tracing on, and
+ * -DTRACE_CATEGORIES=<bits> to keep only some categories. the text goes to
+ * cerr, in time order across threads.
+ */
+
+#include "connor.h"
+
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL 0
+#endif
+#ifndef TRACE_CATEGORIES
+#define TRACE_CATEGORIES 0xffffffffu
+#endif
+
+namespace trace {
+
+enum Level : unsigned { off = 0, info = 1, detail = 2 };
+enum Category : unsigned {
+  templates = 1u << 0,       // which types a template ran with
+  special_members = 1u << 1, // constructors, assignments, destructors
+  general = 1u << 2,
+};
+
+constexpr bool enabled(Level level, Category category) {
+  return level != off && level <= TRACE_LEVEL &&
+         (category & TRACE_CATEGORIES) != 0;
+}
+
+} // namespace trace
+
+// the arguments aren't even evaluated unless the trace is enabled
+#define TRACE(level, category, ...)                                           \
+  do {                                                                        \
+    if constexpr (trace::enabled(level, category))                            \
+      trace::write(__VA_ARGS__);                                              \
+  } while (0)
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+namespace trace {
+
+// marks a string that lives for the whole program (a literal, a
+// typeid().name()), so the record keeps the pointer instead of a copy
+struct Literal {
+  const char *text;
+};
+
+// one TRACE call. arguments take one 8-byte slot each, except text,
+// which is copied into as many slots as are left (and cut off there).
+struct Record {
+  enum Kind : uint8_t { none, i64, u64, f64, literal, text, more_text };
+  static constexpr size_t slot_count = 5;
+
+  int64_t time;       // steady_clock ticks
+  const char *format; // a string literal, {} for each argument
+  Kind kinds[8];      // what each slot holds; only slot_count are used
+  uint64_t slots[slot_count];
+};
+static_assert(sizeof(Record) == 64);
+
+// records from one thread on their way to the formatter. only that thread
+// pushes and only the formatter drains, so plain loads and stores on two
+// counters are enough; when it is full new records are dropped and
+// counted rather than making the traced code wait.
+class Ring {
+public:
+  static constexpr size_t capacity = 4096; // a power of two
+
+  explicit Ring(int thread) : thread{thread} {}
+
+  void push(const Record &r) {
+    uint64_t h = head.load(memory_order_relaxed);
+    if (h - tail.load(memory_order_acquire) == capacity) {
+      dropped.fetch_add(1, memory_order_relaxed);
+      return;
+    }
+    records[h & (capacity - 1)] = r;
+    head.store(h + 1, memory_order_release);
+  }
+
+  template <typename F> void drain(F &&f) {
+    uint64_t t = tail.load(memory_order_relaxed);
+    uint64_t h = head.load(memory_order_acquire);
+    for (; t != h; ++t)
+      f(records[t & (capacity - 1)]);
+    tail.store(t, memory_order_release);
+  }
+
+  const int thread;
+  atomic<uint64_t> dropped{0};
+
+private:
+  array<Record, capacity> records;
+  alignas(64) atomic<uint64_t> head{0}; // next slot to write
+  alignas(64) atomic<uint64_t> tail{0}; // next slot to read
+};
+
+// owns every thread's Ring and the thread that formats their records.
+// it starts with the first trace and writes out what is left at exit.
+class Collector {
+public:
+  static Collector &get() {
+    static Collector c;
+    return c;
+  }
+
+  Ring &ring() {
+    thread_local shared_ptr<Ring> mine = add_ring();
+    return *mine;
+  }
+
+  ~Collector() {
+    {
+      lock_guard<mutex> lk{m};
+      stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+    flush();
+  }
+
+  // formats everything recorded so far
+  void flush() {
+    lock_guard<mutex> lk{drain_lock};
+    vector<pair<Record, int>> batch; // each record and its thread
+    {
+      lock_guard<mutex> lk2{m};
+      for (const shared_ptr<Ring> &r : rings) {
+        r->drain([&](const Record &rec) { batch.push_back({rec, r->thread}); });
+        if (uint64_t d = r->dropped.exchange(0))
+          cerr << "[trace] thread " << r->thread << " dropped " << d
+               << " records\n";
+      }
+    }
+    stable_sort(batch.begin(), batch.end(), [](auto &a, auto &b) {
+      return a.first.time < b.first.time;
+    });
+    for (auto &[rec, thread] : batch)
+      print(rec, thread);
+  }
+
+private:
+  Collector() : start{chrono::steady_clock::now()} {
+    worker = std::thread([this] {
+      unique_lock<mutex> lk{m};
+      while (!stopping) {
+        wake.wait_for(lk, chrono::milliseconds(20));
+        lk.unlock();
+        flush();
+        lk.lock();
+      }
+    });
+  }
+
+  shared_ptr<Ring> add_ring() {
+    lock_guard<mutex> lk{m};
+    rings.push_back(make_shared<Ring>(static_cast<int>(rings.size())));
+    return rings.back();
+  }
+
+  void print(const Record &r, int thread) const {
+    int64_t ns = chrono::duration_cast<chrono::nanoseconds>(
+                     chrono::steady_clock::duration(r.time) -
+                     start.time_since_epoch())
+                     .count();
+    // microseconds since the collector started, to three places
+    char when[32];
+    snprintf(when, sizeof when, "%.3f", static_cast<double>(ns) / 1000);
+    cerr << "[" << when << " us, thread " << thread << "] ";
+    size_t slot = 0;
+    for (const char *f = r.format; *f; ++f) {
+      if (f[0] == '{' && f[1] == '}') {
+        print_arg(r, slot);
+        ++f;
+      } else {
+        cerr << *f;
+      }
+    }
+    cerr << '\n';
+  }
+
+  static void print_arg(const Record &r, size_t &slot) {
+    if (slot >= Record::slot_count) {
+      cerr << "{}";
+      return;
+    }
+    uint64_t v = r.slots[slot];
+    switch (r.kinds[slot++]) {
+    case Record::i64:
+      cerr << static_cast<int64_t>(v);
+      break;
+    case Record::u64:
+      cerr << v;
+      break;
+    case Record::f64:
+      cerr << bit_cast<double>(v);
+      break;
+    case Record::literal:
+      cerr << reinterpret_cast<const char *>(v);
+      break;
+    case Record::text: {
+      string s(reinterpret_cast<const char *>(&v), sizeof v);
+      while (slot < Record::slot_count && r.kinds[slot] == Record::more_text)
+        s.append(reinterpret_cast<const char *>(&r.slots[slot++]), 8);
+      cerr << s.c_str(); // stops at the end of the copied text
+      break;
+    }
+    default:
+      cerr << "{}";
+    }
+  }
+
+  const chrono::steady_clock::time_point start;
+  mutex m; // guards rings and stopping
+  mutex drain_lock;
+  condition_variable wake;
+  vector<shared_ptr<Ring>> rings; // kept after their threads end
+  bool stopping = false;
+  std::thread worker;
+};
+
+// filling in a Record's slots, one argument at a time
+inline void put(Record &r, size_t &slot, Literal s) {
+  if (slot < Record::slot_count) {
+    r.kinds[slot] = Record::literal;
+    r.slots[slot++] = reinterpret_cast<uint64_t>(s.text);
+  }
+}
+inline void put(Record &r, size_t &slot, string_view s) {
+  if (slot >= Record::slot_count)
+    return;
+  // text plus a '\0' in whatever slots are left
+  size_t room = (Record::slot_count - slot) * 8 - 1;
+  size_t len = min(s.size(), room);
+  size_t used = len / 8 + 1;
+  char *dest = reinterpret_cast<char *>(&r.slots[slot]);
+  memcpy(dest, s.data(), len);
+  memset(dest + len, 0, used * 8 - len);
+  r.kinds[slot] = Record::text;
+  for (size_t i = 1; i < used; ++i)
+    r.kinds[slot + i] = Record::more_text;
+  slot += used;
+}
+inline void put(Record &r, size_t &slot, const char *s) {
+  put(r, slot, s ? string_view{s} : string_view{"null"});
+}
+inline void put(Record &r, size_t &slot, const string &s) {
+  put(r, slot, string_view{s});
+}
+template <typename T>
+  requires is_arithmetic_v<T>
+void put(Record &r, size_t &slot, T v) {
+  if (slot >= Record::slot_count)
+    return;
+  if constexpr (is_same_v<T, char>) {
+    put(r, slot, string_view{&v, 1});
+    return;
+  } else if constexpr (is_floating_point_v<T>) {
+    r.kinds[slot] = Record::f64;
+    r.slots[slot] = bit_cast<uint64_t>(static_cast<double>(v));
+  } else if constexpr (is_signed_v<T>) {
+    r.kinds[slot] = Record::i64;
+    r.slots[slot] = static_cast<uint64_t>(static_cast<int64_t>(v));
+  } else {
+    r.kinds[slot] = Record::u64;
+    r.slots[slot] = static_cast<uint64_t>(v);
+  }
+  ++slot;
+}
+
+// what TRACE calls when it is enabled
+template <typename... Args>
+void write(const char *format, const Args &...args) {
+  Ring &ring = Collector::get().ring(); // first, so time is after start
+  Record r;
+  r.time = chrono::steady_clock::now().time_since_epoch().count();
+  r.format = format;
+  fill(begin(r.kinds), end(r.kinds), Record::none);
+  [[maybe_unused]] size_t slot = 0;
+  (put(r, slot, args), ...);
+  ring.push(r);
+}
+
+} // namespace trace